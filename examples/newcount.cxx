@@ -0,0 +1,59 @@
+// Count calls of the global operator new, for the allocation check in
+// dcsimbench.C.  Build and preload it when starting hcana:
+//
+// g++ -shared -fPIC -O2 -o newcount.so newcount.cxx
+// LD_PRELOAD=./newcount.so hcana
+//
+// A replacement operator new in a macro loaded with ACLiC would not be
+// seen by libraries that are already loaded, so this has to be preloaded.
+
+#include <cstdlib>
+#include <new>
+
+extern "C" {
+  long hcana_new_count = 0;	// Read by dcsimbench.C through dlsym
+}
+
+void* operator new(std::size_t n)
+{
+  hcana_new_count++;
+  void* p = std::malloc(n ? n : 1);
+  if(!p) throw std::bad_alloc();
+  return p;
+}
+
+void* operator new[](std::size_t n)
+{
+  return operator new(n);
+}
+
+void* operator new(std::size_t n, const std::nothrow_t&) throw()
+{
+  hcana_new_count++;
+  return std::malloc(n ? n : 1);
+}
+
+void* operator new[](std::size_t n, const std::nothrow_t&) throw()
+{
+  return operator new(n, std::nothrow);
+}
+
+void operator delete(void* p) throw()
+{
+  std::free(p);
+}
+
+void operator delete[](void* p) throw()
+{
+  std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) throw()
+{
+  std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) throw()
+{
+  std::free(p);
+}
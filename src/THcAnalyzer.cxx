@@ -9,6 +9,11 @@ Adds the following to the Hall A analyzer base class.
 
 2.  Retrieve run number and startind and ending event from parameter DB
 
+3.  Count the event loop warnings of gHcDiagnostics per run and print
+    them at the end of the analysis
+
+4.  Empty the event level caches of the hit lists before each event is decoded
+
 \author S. A. Wood,  13-March-2012
 
 */
@@ -19,6 +24,8 @@ Adds the following to the Hall A analyzer base class.
 #include "THcParmList.h"
 #include "THcFormula.h"
 #include "THcGlobals.h"
+#include "THcDiagnostics.h"
+#include "THcHitList.h"
 #include "TMath.h"
 
 #include <fstream>
@@ -49,6 +56,35 @@ THcAnalyzer::~THcAnalyzer()
 
 }
 
+//_____________________________________________________________________________
+Int_t THcAnalyzer::BeginAnalysis()
+{
+  /// Start counting the event loop warnings of gHcDiagnostics from
+  /// zero, then begin the analysis as THaAnalyzer does
+  if(gHcDiagnostics) gHcDiagnostics->Reset();
+  return THaAnalyzer::BeginAnalysis();
+}
+
+//_____________________________________________________________________________
+Int_t THcAnalyzer::EndAnalysis()
+{
+  /// End the analysis as THaAnalyzer does, then print the warnings
+  /// collected in gHcDiagnostics during the event loop
+  Int_t retval = THaAnalyzer::EndAnalysis();
+  if(gHcDiagnostics) gHcDiagnostics->Flush();
+  return retval;
+}
+
+//_____________________________________________________________________________
+Int_t THcAnalyzer::PhysicsAnalysis( Int_t code )
+{
+  /// Empty the reference time cache and channel owner map shared by the
+  /// hit lists, then analyze the event as THaAnalyzer does.  The
+  /// apparatuses are decoded in THaAnalyzer::PhysicsAnalysis.
+  THcHitList::ResetEventCaches();
+  return THaAnalyzer::PhysicsAnalysis(code);
+}
+
 //_____________________________________________________________________________
 void THcAnalyzer::PrintReport(const char* templatefile, const char* ofile)
 {
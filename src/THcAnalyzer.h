@@ -22,6 +22,10 @@ public:
 
 protected:
 
+  virtual Int_t BeginAnalysis();
+  virtual Int_t EndAnalysis();
+  virtual Int_t PhysicsAnalysis( Int_t code );
+
   Int_t fPedestalEvtype;
 
 private:
@@ -0,0 +1,195 @@
+/** \class THcChannelOwnerMap
+    \ingroup Base
+
+\brief Event-level map from electronics channels to the hit lists that own them
+
+Each THcHitList registers the (crate, slot, chan) of every channel in
+its detector map.  The first hit list that asks for its fired channels
+in an event triggers one walk of the event data over all registered
+crates and slots.  The fired channels are scattered to their owners,
+so later hit lists of the same event get their channels without
+walking the event data again.
+
+Reset() must be called before the first request of each event.
+THcHitList::ResetEventCaches does this, called by THcAnalyzer before
+the apparatuses decode.  A single instance, gHcChannelOwnerMap, is shared by all hit
+lists.
+
+*/
+#include "THcChannelOwnerMap.h"
+
+using namespace std;
+
+THcChannelOwnerMap::THcChannelOwnerMap() :
+  fIndexValid(kFALSE), fValid(kFALSE),
+  fNLookups(0), fNScans(0)
+{
+  /// Normal constructor.
+}
+
+THcChannelOwnerMap::~THcChannelOwnerMap()
+{
+  /// Destructor
+}
+
+Int_t THcChannelOwnerMap::Register()
+{
+  /**
+\brief Add a new owner
+
+\return Owner number to use with AddChannel and GetFiredChannels
+  */
+  fRegistered.push_back(kTRUE);
+  fFired.push_back(vector<Int_t>());
+  return fRegistered.size()-1;
+}
+
+void THcChannelOwnerMap::Unregister(Int_t owner)
+{
+  /// Drop all channels of owner.  The owner number is not reused.
+  if(owner < 0 || (UInt_t) owner >= fRegistered.size()) return;
+  fRegistered[owner] = kFALSE;
+  fFired[owner].clear();
+  UInt_t nkeep = 0;
+  for(UInt_t i=0; i<fChannels.size(); i++) {
+    if(fChannels[i].owner != owner) {
+      fChannels[nkeep++] = fChannels[i];
+    }
+  }
+  fChannels.resize(nkeep);
+  fIndexValid = kFALSE;
+  fValid = kFALSE;
+}
+
+void THcChannelOwnerMap::AddChannel(Int_t owner, Int_t crate, Int_t slot,
+				    Int_t chan, Int_t entry)
+{
+  /**
+\brief Claim a channel for owner
+
+\param[in] owner Owner number from Register
+\param[in] crate,slot,chan Channel
+\param[in] entry Owner's index for this channel, returned by GetFiredChannels
+
+A channel can be claimed several times, by the same or different
+owners.  GetFiredChannels returns the entries in event scan order, not
+in the order they were added.
+  */
+  if(owner < 0 || (UInt_t) owner >= fRegistered.size()
+     || !fRegistered[owner]) {
+    return;
+  }
+  Channel c;
+  c.crate = crate;
+  c.slot = slot;
+  c.chan = chan;
+  c.owner = owner;
+  c.entry = entry;
+  c.next = -1;
+  fChannels.push_back(c);
+  fIndexValid = kFALSE;
+  fValid = kFALSE;
+}
+
+void THcChannelOwnerMap::BuildIndex()
+{
+  /// Index the claimed channels by crate, slot and channel
+  fCrateSlots.clear();
+  for(UInt_t i=0; i<fChannels.size(); i++) {
+    const Channel& c = fChannels[i];
+    UInt_t ics = 0;
+    while(ics < fCrateSlots.size()) {
+      if(fCrateSlots[ics].crate == c.crate
+	 && fCrateSlots[ics].slot == c.slot) break;
+      ics++;
+    }
+    if(ics == fCrateSlots.size()) {
+      CrateSlot cs;
+      cs.crate = c.crate;
+      cs.slot = c.slot;
+      cs.lochan = c.chan;
+      cs.hichan = c.chan;
+      cs.offset = 0;
+      fCrateSlots.push_back(cs);
+    } else {
+      if(c.chan < fCrateSlots[ics].lochan) fCrateSlots[ics].lochan = c.chan;
+      if(c.chan > fCrateSlots[ics].hichan) fCrateSlots[ics].hichan = c.chan;
+    }
+  }
+  Int_t nindex = 0;
+  for(UInt_t ics=0; ics < fCrateSlots.size(); ics++) {
+    fCrateSlots[ics].offset = nindex;
+    nindex += fCrateSlots[ics].hichan - fCrateSlots[ics].lochan + 1;
+  }
+  fChannelIndex.assign(nindex, -1);
+
+  // Chain the owners of each channel in the order they were added
+  for(UInt_t i=0; i<fChannels.size(); i++) {
+    Channel& c = fChannels[i];
+    c.next = -1;
+    UInt_t ics = 0;
+    while(fCrateSlots[ics].crate != c.crate
+	  || fCrateSlots[ics].slot != c.slot) ics++;
+    Int_t* link = &fChannelIndex[fCrateSlots[ics].offset + c.chan
+				 - fCrateSlots[ics].lochan];
+    while(*link >= 0) link = &fChannels[*link].next;
+    *link = i;
+  }
+  fIndexValid = kTRUE;
+}
+
+void THcChannelOwnerMap::ScanEvent(const THaEvData& evdata)
+{
+  /// Walk the event data once and hand each fired channel to its owners
+  if(!fIndexValid) BuildIndex();
+  fNScans++;
+  for(UInt_t owner=0; owner<fFired.size(); owner++) {
+    fFired[owner].clear();
+  }
+  for(UInt_t ics=0; ics < fCrateSlots.size(); ics++) {
+    const CrateSlot& cs = fCrateSlots[ics];
+
+    // Loop over all channels that have a hit.
+    Int_t nchan = evdata.GetNumChan(cs.crate, cs.slot);
+    for(Int_t j=0; j < nchan; j++) {
+      Int_t chan = evdata.GetNextChan(cs.crate, cs.slot, j);
+      if(chan < cs.lochan || chan > cs.hichan) continue; // Not claimed
+
+      Int_t ichan = fChannelIndex[cs.offset + chan - cs.lochan];
+      while(ichan >= 0) {
+	const Channel& c = fChannels[ichan];
+	fFired[c.owner].push_back(c.entry);
+	ichan = c.next;
+      }
+    }
+  }
+  fValid = kTRUE;
+}
+
+const vector<Int_t>& THcChannelOwnerMap::GetFiredChannels(const THaEvData& evdata,
+							  Int_t owner)
+{
+  /**
+\brief Get the fired channels of owner in the current event
+
+\param[in] evdata Event data
+\param[in] owner Owner number from Register
+\return Entries given to AddChannel for the channels with data
+
+The entries come in event scan order: crate/slot in the order they
+were first claimed, then channels in the order the event data lists
+them.  The owners of a channel claimed more than once are listed in the
+order they were added.
+  */
+  fNLookups++;
+  if(!fValid) ScanEvent(evdata);
+  return fFired[owner];
+}
+
+void THcChannelOwnerMap::Reset()
+{
+  /// Forget the fired channels.  Call at the start of every event.
+  fValid = kFALSE;
+}
+
+ClassImp(THcChannelOwnerMap)
@@ -0,0 +1,69 @@
+#ifndef ROOT_THcChannelOwnerMap
+#define ROOT_THcChannelOwnerMap
+
+//////////////////////////////////////////////////////////////////////////
+//
+// THcChannelOwnerMap
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "TObject.h"
+#include "THaEvData.h"
+
+#include <vector>
+
+class THcChannelOwnerMap : public TObject {
+
+public:
+
+  THcChannelOwnerMap();
+  virtual ~THcChannelOwnerMap();
+
+  Int_t  Register();
+  void   Unregister(Int_t owner);
+  void   AddChannel(Int_t owner, Int_t crate, Int_t slot, Int_t chan,
+		    Int_t entry);
+  const std::vector<Int_t>& GetFiredChannels(const THaEvData& evdata,
+					     Int_t owner);
+  void   Reset();
+
+  UInt_t GetNLookups() const { return fNLookups; }
+  UInt_t GetNScans() const { return fNScans; }
+
+protected:
+
+  struct Channel {		// One channel claimed by one owner
+    Int_t crate;
+    Int_t slot;
+    Int_t chan;
+    Int_t owner;
+    Int_t entry;		// Owner's index for this channel
+    Int_t next;			// Next owner of the same channel, -1 if none
+  };
+  struct CrateSlot {		// One crate/slot with claimed channels
+    Int_t crate;
+    Int_t slot;
+    Int_t lochan;		// Lowest claimed channel
+    Int_t hichan;		// Highest claimed channel
+    Int_t offset;		// Position of lochan in fChannelIndex
+  };
+
+  void BuildIndex();
+  void ScanEvent(const THaEvData& evdata);
+
+  std::vector<Channel> fChannels;
+  std::vector<CrateSlot> fCrateSlots;
+  std::vector<Int_t> fChannelIndex; // (crate, slot, chan) -> first channel, -1 if unclaimed
+  Bool_t fIndexValid;		    // fCrateSlots and fChannelIndex are up to date
+
+  std::vector<Bool_t> fRegistered;	     // Owner is registered
+  std::vector<std::vector<Int_t> > fFired; // Fired entries of each owner
+
+  Bool_t fValid;		// fFired holds the current event
+
+  UInt_t fNLookups;		// Fired channel requests
+  UInt_t fNScans;		// Requests that had to walk the event data
+
+  ClassDef(THcChannelOwnerMap,0);  // Event-level map of fired channels to hit lists
+};
+#endif
@@ -370,6 +370,42 @@ Int_t THcConfigEvtHandler::GetNPED(Int_t crate) {
   }
   return(-1);
 }
+Int_t THcConfigEvtHandler::GetNP(Int_t crate) {
+  if(CrateInfoMap.find(crate)!=CrateInfoMap.end()) {
+    CrateInfo_t *cinfo = CrateInfoMap[crate];
+    if(cinfo->FADC250.present > 0) return(cinfo->FADC250.np);
+  }
+  return(-1);
+}
+Int_t THcConfigEvtHandler::GetNSAT(Int_t crate) {
+  if(CrateInfoMap.find(crate)!=CrateInfoMap.end()) {
+    CrateInfo_t *cinfo = CrateInfoMap[crate];
+    if(cinfo->FADC250.present > 0) return(cinfo->FADC250.nsat);
+  }
+  return(-1);
+}
+Int_t THcConfigEvtHandler::GetMAXPED(Int_t crate) {
+  if(CrateInfoMap.find(crate)!=CrateInfoMap.end()) {
+    CrateInfo_t *cinfo = CrateInfoMap[crate];
+    if(cinfo->FADC250.present > 0) return(cinfo->FADC250.maxped);
+  }
+  return(-1);
+}
+Int_t THcConfigEvtHandler::GetThreshold(Int_t crate, Int_t slot, Int_t chan) {
+  // Threshold of one channel from the 0xdafadcff block, or the crate
+  // wide threshold if the slot has no thresholds.
+  if(CrateInfoMap.find(crate)!=CrateInfoMap.end()) {
+    CrateInfo_t *cinfo = CrateInfoMap[crate];
+    if(cinfo->FADC250.present > 0) {
+      std::map<Int_t, Int_t *>::iterator itt = cinfo->FADC250.thresholds.find(slot);
+      if(itt != cinfo->FADC250.thresholds.end() && chan >= 0 && chan < 16) {
+	return(itt->second[chan]);
+      }
+      return(cinfo->FADC250.threshold);
+    }
+  }
+  return(-1);
+}
 void THcConfigEvtHandler::AddEventType(Int_t evtype)
 {
   eventtypes.push_back(evtype);
@@ -29,6 +29,10 @@ public:
   virtual Int_t GetNSA(Int_t crate);
   virtual Int_t GetNSB(Int_t crate);
   virtual Int_t GetNPED(Int_t crate);
+  virtual Int_t GetNP(Int_t crate);
+  virtual Int_t GetNSAT(Int_t crate);
+  virtual Int_t GetMAXPED(Int_t crate);
+  virtual Int_t GetThreshold(Int_t crate, Int_t slot, Int_t chan);
   virtual EStatus Init( const TDatime& run_time);
  //  Float_t GetData(const std::string& tag);
   virtual void MakeParms(Int_t roc);
@@ -25,13 +25,14 @@ the number of parameters per plane.
 #include "THaTrack.h"
 #include "TClonesArray.h"
 #include "TMath.h"
-#include "TVectorD.h"
 #include "THaApparatus.h"
+#include "TROOT.h"
 
 #include <cstring>
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
+#include <algorithm>
 
 using namespace std;
 
@@ -83,6 +84,7 @@ THcDC::THcDC(
 
   fNChamHits = 0;
   fPlaneEvents = 0;
+  fMaskedHits = 0;
 
   //The version defaults to 0 (old HMS style). 1 is new HMS style and 2 is SHMS style.
   fVersion = 0;
@@ -333,6 +335,14 @@ Int_t THcDC::ReadDatabase( const TDatime& date )
     {"dc_plane_time_zero", fPlaneTimeZero, kDouble, (UInt_t)fNPlanes},
     {"dc_sigma", fSigma, kDouble, (UInt_t)fNPlanes},
     {"single_stub",&fSingleStub, kInt,0,1},
+    {"dc_parallel_chambers",&fParallelChambers, kInt,0,1},
+    {"dc_tracking_mode",&fTrackingMode, kInt,0,1},
+    {"dc_hough_binsize",&fHoughBinSize, kDouble,0,1},
+    {"dc_hough_max_peaks",&fHoughMaxPeaks, kInt,0,1},
+    {"dc_hough_max_slope",&fHoughMaxSlope, kDouble,0,1},
+    {"dc_mask_deadwires",&fMaskDeadWires, kInt,0,1},
+    {"dc_hotwire_occupancy",&fHotWireOccupancy, kDouble,0,1},
+    {"dc_hotwire_nevents",&fHotWireNEvents, kInt,0,1},
     {"ntracks_max_fp", &fNTracksMaxFP, kInt},
     {"xt_track_criterion", &fXtTrCriterion, kDouble},
     {"yt_track_criterion", &fYtTrCriterion, kDouble},
@@ -349,6 +359,14 @@ Int_t THcDC::ReadDatabase( const TDatime& date )
     {0}
   };
   fSingleStub=0;
+  fParallelChambers=0;
+  fTrackingMode=0;
+  fHoughBinSize=1.0;
+  fHoughMaxPeaks=4;
+  fHoughMaxSlope=0.2;
+  fMaskDeadWires=0;
+  fHotWireOccupancy=0.0;
+  fHotWireNEvents=1000;
    for(Int_t ip=0; ip<fNPlanes;ip++) {
     fReadoutLR[ip] = 0.0;
     fReadoutTB[ip] = 0.0;
@@ -371,6 +389,78 @@ Int_t THcDC::ReadDatabase( const TDatime& date )
    };
    gHcParms->LoadParmValues((DBRequest*)&listOpt,fPrefix);
   if(fNTracksMaxFP <= 0) fNTracksMaxFP = 10;
+  if(fHotWireNEvents <= 0) fHotWireNEvents = 1000;
+
+  // Dead wires, (plane,wire) pairs.  The planes mask them if
+  // dc_mask_deadwires is set.
+  Int_t ndeadwires = 0;
+  DBRequest listDead[]={
+    {"dc_num_deadwires", &ndeadwires, kInt, 0, 1},
+    {0}
+  };
+  gHcParms->LoadParmValues((DBRequest*)&listDead,fPrefix);
+  fDeadWirePlane.assign(TMath::Max(ndeadwires,0), 0);
+  fDeadWireNum.assign(TMath::Max(ndeadwires,0), 0);
+  if(ndeadwires > 0) {
+    DBRequest listDeadWires[]={
+      {"dc_deadwire_plane", &fDeadWirePlane[0], kInt, (UInt_t)ndeadwires},
+      {"dc_deadwire_num", &fDeadWireNum[0], kInt, (UInt_t)ndeadwires},
+      {0}
+    };
+    gHcParms->LoadParmValues((DBRequest*)&listDeadWires,fPrefix);
+  }
+
+  // Hough grid covers all wires of all planes
+  if(fTrackingMode == 1 && fNChambers != 2) {
+    static const char* const here = "ReadDatabase()";
+    Warning( Here(here), "Hough tracking needs two chambers.  Using space points.");
+    fTrackingMode = 0;
+  }
+  // Hough candidates can share hits, so each one keeps its own
+  // propagation corrected distances
+  if(fTrackingMode == 1 && fFixPropagationCorrection == 0) {
+    static const char* const here = "ReadDatabase()";
+    Warning( Here(here), "Hough tracking needs dc_fix_propcorr.  Setting it to 1.");
+    fFixPropagationCorrection = 1;
+  }
+  if(fHoughBinSize <= 0) fHoughBinSize = 1.0;
+  Double_t halfsize = 0.0;
+  for(Int_t ip=0;ip<fNPlanes;ip++) {
+    halfsize = TMath::Max(halfsize, fNWires[ip]*fPitch[ip]/2);
+  }
+  Double_t maxcenter = 0.0;
+  fHoughZ.assign(fNChambers, 0.0);
+  std::vector<Int_t> nchamberplanes(fNChambers, 0);
+  for(UInt_t ich=0;ich<fNChambers;ich++) {
+    maxcenter = TMath::Max(maxcenter, TMath::Abs(fXCenter[ich]));
+    maxcenter = TMath::Max(maxcenter, TMath::Abs(fYCenter[ich]));
+  }
+  for(Int_t ip=0;ip<fNPlanes;ip++) {
+    fHoughZ[fNChamber[ip]-1] += fZPos[ip];
+    nchamberplanes[fNChamber[ip]-1]++;
+  }
+  for(UInt_t ich=0;ich<fNChambers;ich++) {
+    if(nchamberplanes[ich] > 0) fHoughZ[ich] /= nchamberplanes[ich];
+  }
+  fHoughMin = -(halfsize + maxcenter);
+  fHoughNBins = TMath::CeilNint(-2*fHoughMin/fHoughBinSize);
+  fHoughTouched.clear();
+  if(fTrackingMode == 1) {
+    fHoughMask.assign(fHoughNBins*fHoughNBins, 0);
+  }
+  fHoughPeaks.resize(fNChambers);
+#ifdef _OPENMP
+  // The chambers construct space points in their TClonesArrays while
+  // running in parallel, which goes through TClass and needs ROOT's
+  // global locks
+  if(fParallelChambers) ROOT::EnableThreadSafety();
+#else
+  if(fParallelChambers) {
+    static const char* const here = "ReadDatabase()";
+    Warning( Here(here), "dc_parallel_chambers is set, but hcana was built "
+	     "without OpenMP.  Chambers are processed one after the other.");
+  }
+#endif
   // if(fNTracksMaxFP > HNRACKS_MAX) fNTracksMaxFP = NHTRACKS_MAX;
   cout << "Plane counts:";
   for(Int_t i=0;i<fNPlanes;i++) {
@@ -480,6 +570,7 @@ void THcDC::DeleteArrays()
   // Efficiency arrays
   delete [] fNChamHits; fNChamHits = NULL;
   delete [] fPlaneEvents; fPlaneEvents = NULL;
+  delete [] fMaskedHits; fMaskedHits = NULL;
 
   for( Int_t i = 0; i<fNPlanes; ++i )
     delete [] fPlaneNames[i];
@@ -529,7 +620,6 @@ Int_t THcDC::Decode( const THaEvData& evdata )
     Pass hit list to the planes.
     Load hits from planes into chamber objects
   */
-  ClearEvent();
   Int_t num_event = evdata.GetEvNum();
   if (fdebugprintrawdc ||fdebugprintdecodeddc || fdebuglinkstubs || fdebugtrackprint) cout << " event num = " << num_event << endl;
   // Get the Hall C style hitlist (fRawHitList) for this event
@@ -538,19 +628,13 @@ Int_t THcDC::Decode( const THaEvData& evdata )
   if(fPresentP) {		// if this spectrometer not part of trigger
     present = *fPresentP;
   }
-  fNhits = DecodeToHitList(evdata, !present);
+  Int_t nhits = DecodeToHitList(evdata, !present);
 
+  Bool_t pedestal = gHaCuts->Result("Pedestal_event");
+  LoadPlaneHits(fRawHitList, !pedestal);
+  fNhits = nhits;
 
-
-  if(!gHaCuts->Result("Pedestal_event")) {
-    // Let each plane get its hits
-    Int_t nexthit = 0;
-    for(Int_t ip=0;ip<fNPlanes;ip++) {
-      nexthit = fPlanes[ip]->ProcessHits(fRawHitList, nexthit);
-      fN_True_RawHits += fPlanes[ip]->GetNRawhits();
-
-    }
-
+  if(!pedestal) {
     // fRawHitList is TClones array of THcRawDCHit objects
     Int_t counter=0;
     if (fdebugprintrawdc) {
@@ -570,6 +654,36 @@ Int_t THcDC::Decode( const THaEvData& evdata )
   return fNhits;
 }
 
+//_____________________________________________________________________________
+Int_t THcDC::LoadRawHits( TClonesArray* rawhits )
+{
+  /**
+    Use a list of THcRawDCHit, sorted by plane, in place of Decode.
+    Lets generated hits go through the same plane and chamber code as
+    data, for example from THcDCEventGenerator.  Returns the number of
+    raw hits.
+  */
+  LoadPlaneHits(rawhits, kTRUE);
+  fNhits = rawhits->GetLast()+1;
+  return fNhits;
+}
+
+//_____________________________________________________________________________
+void THcDC::LoadPlaneHits( TClonesArray* rawhits, Bool_t process )
+{
+  /**
+    Reset the event and, if process is set, let each plane take its
+    hits from rawhits.  Shared by Decode and LoadRawHits.
+  */
+  ClearEvent();
+  if(!process) return;
+  Int_t nexthit = 0;
+  for(Int_t ip=0;ip<fNPlanes;ip++) {
+    nexthit = fPlanes[ip]->ProcessHits(rawhits, nexthit);
+    fN_True_RawHits += fPlanes[ip]->GetNRawhits();
+  }
+}
+
 //_____________________________________________________________________________
 Int_t THcDC::ApplyCorrections( void )
 {
@@ -597,15 +711,29 @@ Int_t THcDC::CoarseTrack( TClonesArray& tracks )
       if (fdebugprintdecodeddc)fChambers[ic]->PrintDecode();
     }
     //
-  for(UInt_t i=0;i<fNChambers;i++) {
-    fChambers[i]->FindSpacePoints();
-    fChambers[i]->CorrectHitTimes();
-    fChambers[i]->LeftRight();
+  if(fTrackingMode == 1) {
+    // Tracks straight from the hits, no space points or stubs
+    HoughTracks();
+  } else {
+    // Space points and stubs of one chamber only use the hits and
+    // space points of that chamber, so with dc_parallel_chambers the
+    // chambers run on the OpenMP thread pool.  Each chamber does the
+    // same work as in serial mode, so the results are identical.
+    // Debug printout of the chambers may be interleaved.
+    Int_t nchambers = fNChambers;
+#ifdef _OPENMP
+#pragma omp parallel for if(fParallelChambers && nchambers > 1) num_threads(nchambers) schedule(static,1)
+#endif
+    for(Int_t i=0;i<nchambers;i++) {
+      fChambers[i]->FindSpacePoints();
+      fChambers[i]->CorrectHitTimes();
+      fChambers[i]->LeftRight();
+    }
+    if (fdebugflagstubs) PrintSpacePoints();
+    if (fdebugflagstubs)  PrintStubs();
+    // Now link the stubs between chambers
+    LinkStubs();
   }
-  if (fdebugflagstubs) PrintSpacePoints();
-  if (fdebugflagstubs)  PrintStubs();
-  // Now link the stubs between chambers
-  LinkStubs();
  if(fNDCTracks > 0) {
      TrackFit();
     // Copy tracks into podd tracks list
@@ -723,7 +851,9 @@ void THcDC::LinkStubs()
                     0) Put all space points in a single list
                     1) loop over all space points as seeds  isp1
                     2) Check if this space point is all ready in a track
-                    3) loop over all succeeding space pointss   isp2
+                    3) loop over all succeeding space points isp2 with
+                       stub x within fXtTrCriterion of isp1.  These are
+                       found in a list sorted by stub x.
                     4)  check if there is a track-criterion match
                          either add to existing track
                          or if there is another point in same chamber
@@ -733,12 +863,10 @@ void THcDC::LinkStubs()
                        stubs.
   */
 
-  std::vector<THcSpacePoint*> fSp;
   fNSp=0;
   fSp.clear();
-  fSp.reserve(10);
   fNDCTracks=0;		// Number of Focal Plane tracks found
-  fDCTracks->Delete();
+  fDCTracks->Clear();
   // Make a vector of pointers to the SpacePoints
   if (fChambers[0]->GetNSpacePoints()+fChambers[1]->GetNSpacePoints()>10) return;
 
@@ -749,6 +877,7 @@ void THcDC::LinkStubs()
       fSp.push_back(static_cast<THcSpacePoint*>(spacepointarray->At(isp)));
       fSp[fNSp]->fNChamber = nchamber;
       fSp[fNSp]->fNChamber_spnum = isp;
+      fSp[fNSp]->fTrackMask = 0;
       fNSp++;
       if (fNSp>10) break;
     }
@@ -759,26 +888,38 @@ void THcDC::LinkStubs()
   Double_t stubminyp = 999999;
   Int_t stub_tracks[MAXTRACKS];
   if(fSingleStub==0) {
+    // Space points with a stub, sorted by stub x
+    std::vector<std::pair<Double_t,Int_t> >& spbyx = fSpByX;
+    spbyx.clear();
+    for(Int_t isp=0;isp<fNSp;isp++) {
+      if(fSp[isp]->GetSetStubFlag()) {
+	spbyx.push_back(std::make_pair(fSp[isp]->GetStubX(), isp));
+      }
+    }
+    std::sort(spbyx.begin(), spbyx.end());
+    std::vector<Int_t>& candidates = fLinkCandidates;
     for(Int_t isp1=0;isp1<fNSp-1;isp1++) { // isp1 is index/id in total list of space points
       THcSpacePoint* sp1 = fSp[isp1];
       Int_t sptracks=0;
-      // Now make sure this sp is not already used in a sp.
-      // Could this be done by having a sp point to the track it is in?
-      Int_t tryflag=1;
-      for(UInt_t itrack=0;itrack<fNDCTracks;itrack++) {
-	THcDCTrack *theDCTrack = static_cast<THcDCTrack*>( fDCTracks->At(itrack));
-	for(Int_t isp=0;isp<theDCTrack->GetNSpacePoints();isp++) {
-	  // isp is index into list of space points attached to theDCTrack
-	  if(theDCTrack->GetSpacePoint(isp) == sp1) {
-	    tryflag=0;
-	  }
+      // Now make sure this sp is not already used in a track.
+      // fTrackMask has a bit set for each track the sp is in.
+      Int_t tryflag=(sp1->fTrackMask == 0);
+      if(tryflag && sp1->GetSetStubFlag()) { // SP not already part of a track
+	// Succeeding space points with x close enough, in index order
+	candidates.clear();
+	Double_t x1 = sp1->GetStubX();
+	std::vector<std::pair<Double_t,Int_t> >::const_iterator it =
+	  std::lower_bound(spbyx.begin(), spbyx.end(),
+			   std::make_pair(x1 - fXtTrCriterion, -1));
+	while(it != spbyx.end() && it->first < x1 + fXtTrCriterion) {
+	  if(it->second > isp1) candidates.push_back(it->second);
+	  ++it;
 	}
-      }
-      if(tryflag) { // SP not already part of a track
+	std::sort(candidates.begin(), candidates.end());
 	Int_t newtrack=1;
-	for(Int_t isp2=isp1+1;isp2<fNSp;isp2++) {
-	  THcSpacePoint* sp2=fSp[isp2];
-	  if(sp1->fNChamber!=sp2->fNChamber&&sp1->GetSetStubFlag()&&sp2->GetSetStubFlag()) {
+	for(UInt_t icand=0;icand<candidates.size();icand++) {
+	  THcSpacePoint* sp2=fSp[candidates[icand]];
+	  if(sp1->fNChamber!=sp2->fNChamber) {
 	    Double_t *spstub1=sp1->GetStubP();
 	    Double_t *spstub2=sp2->GetStubP();
 	    Double_t dposx = spstub1[0] - spstub2[0];
@@ -820,7 +961,9 @@ void THcDC::LinkStubs()
 		if(fNDCTracks < MAXTRACKS) {
 		  sptracks=0; // Number of tracks with this seed
 		  stub_tracks[sptracks++] = fNDCTracks;
-		  THcDCTrack *theDCTrack = new( (*fDCTracks)[fNDCTracks++]) THcDCTrack(fNPlanes);
+		  sp1->fTrackMask |= 1U<<fNDCTracks;
+		  sp2->fTrackMask |= 1U<<fNDCTracks;
+		  THcDCTrack *theDCTrack = AddDCTrack();
 		  theDCTrack->AddSpacePoint(sp1);
 		  theDCTrack->AddSpacePoint(sp2);
 		  if (sp1->fNChamber==1) theDCTrack->SetSp1_ID(sp1->fNChamber_spnum);
@@ -841,21 +984,19 @@ void THcDC::LinkStubs()
 		  Int_t track=stub_tracks[itrack];
 		  THcDCTrack *theDCTrack = static_cast<THcDCTrack*>( fDCTracks->At(track));
 		  Int_t spoint=-1;
-		  Int_t duppoint=0;
-		  for(Int_t isp=0;isp<theDCTrack->GetNSpacePoints();isp++) {
+		  Int_t duppoint=(sp2->fTrackMask>>track) & 1;
+		  for(Int_t isp=0;isp<theDCTrack->GetNSpacePoints() && !duppoint;isp++) {
 		    // isp is index of space points in theDCTrack
 		    if(sp2->fNChamber ==
 		       theDCTrack->GetSpacePoint(isp)->fNChamber) {
 		      spoint=isp;
 		    }
-		    if(sp2==theDCTrack->GetSpacePoint(isp)) {
-		      duppoint=1;
-		    }
 		  } // End loop over sp in tracks with isp1
 		    // If there is no other space point in this chamber
 		    // add this space point to current track(2)
 		  if(!duppoint) {
 		    if(spoint<0) {
+		      sp2->fTrackMask |= 1U<<track;
 		      theDCTrack->AddSpacePoint(sp2);
 		      if (sp2->fNChamber==1) theDCTrack->SetSp1_ID(sp2->fNChamber_spnum);
 		      if (sp2->fNChamber==2) theDCTrack->SetSp2_ID(sp2->fNChamber_spnum);
@@ -865,13 +1006,16 @@ void THcDC::LinkStubs()
 		      // same space points except spoint
  		      if(fNDCTracks < MAXTRACKS) {
 			stub_tracks[sptracks++] = fNDCTracks;
-			THcDCTrack *newDCTrack = new( (*fDCTracks)[fNDCTracks++]) THcDCTrack(fNPlanes);
+			UInt_t newbit = 1U<<fNDCTracks;
+			THcDCTrack *newDCTrack = AddDCTrack();
 			for(Int_t isp=0;isp<theDCTrack->GetNSpacePoints();isp++) {
 			  if(isp!=spoint) {
+			    theDCTrack->GetSpacePoint(isp)->fTrackMask |= newbit;
 			    newDCTrack->AddSpacePoint(theDCTrack->GetSpacePoint(isp));
 		            if (theDCTrack->GetSpacePoint(isp)->fNChamber==1) newDCTrack->SetSp1_ID(theDCTrack->GetSpacePoint(isp)->fNChamber_spnum);
 		            if (theDCTrack->GetSpacePoint(isp)->fNChamber==2) newDCTrack->SetSp2_ID(theDCTrack->GetSpacePoint(isp)->fNChamber_spnum);
 			  } else {
+			    sp2->fTrackMask |= newbit;
 			    newDCTrack->AddSpacePoint(sp2);
 		            if (sp2->fNChamber==1) newDCTrack->SetSp1_ID(sp2->fNChamber_spnum);
 		            if (sp2->fNChamber==2) newDCTrack->SetSp2_ID(sp2->fNChamber_spnum);
@@ -900,7 +1044,7 @@ void THcDC::LinkStubs()
       if(fNDCTracks<MAXTRACKS) {
 	// Need some constructed t thingy
         if (fSp[isp]->GetSetStubFlag()) {
-	  THcDCTrack *newDCTrack = new( (*fDCTracks)[fNDCTracks++]) THcDCTrack(fNPlanes);
+	  THcDCTrack *newDCTrack = AddDCTrack();
 	  newDCTrack->AddSpacePoint(fSp[isp]);
 	}
       } else {
@@ -927,6 +1071,283 @@ void THcDC::LinkStubs()
   }
 }
 
+//_____________________________________________________________________________
+THcDCTrack* THcDC::AddDCTrack()
+{
+  /**
+     Next track candidate in fDCTracks.  Tracks are reused from event
+     to event with their hit lists and per-plane arrays, so no memory is
+     allocated once enough tracks exist.
+  */
+  THcDCTrack* track = static_cast<THcDCTrack*>(fDCTracks->ConstructedAt(fNDCTracks++, "C"));
+  track->SetNPlanes(fNPlanes);
+  return track;
+}
+
+//_____________________________________________________________________________
+static Int_t CountBits(UInt_t x)
+{
+  /// Number of bits set in x
+  Int_t n = 0;
+  while(x) {
+    x &= x-1;
+    n++;
+  }
+  return n;
+}
+
+//_____________________________________________________________________________
+void THcDC::HoughFindPeaks(UInt_t ich)
+{
+  /**
+     Fill the Hough grid with the hits of chamber ich and find the
+     cells where most planes agree.
+
+     A plane measures c4*X + c5*Y, where X and Y are the track position
+     at the plane and c4, c5 the plane coefficients of x and y.  A hit
+     at wire position pos votes for the cells with |c4*X + c5*Y - pos|
+     up to half a wire pitch, so no left/right choice is needed.  The
+     band is widened by half a cell and by the largest slope times the
+     distance of the plane from the middle of the chamber.  Each plane
+     votes at most once per cell.
+
+     Peaks are local maxima with at least min_hit planes.  At most
+     dc_hough_max_peaks are kept, the ones with most planes first.
+  */
+  std::vector<HoughPeak>& peaks = fHoughPeaks[ich];
+  peaks.clear();
+  for(UInt_t i=0;i<fHoughTouched.size();i++) {
+    fHoughMask[fHoughTouched[i]] = 0;
+  }
+  fHoughTouched.clear();
+
+  for(Int_t ip=0;ip<fNPlanes;ip++) {
+    if(fNChamber[ip] != (Int_t) ich+1) continue;
+    Double_t c4 = fPlaneCoeffs[ip][4];
+    Double_t c5 = fPlaneCoeffs[ip][5];
+    Double_t csum = TMath::Abs(c4) + TMath::Abs(c5);
+    Double_t halfwidth = fPitch[ip]/2 + fHoughBinSize*csum/2
+      + fHoughMaxSlope*TMath::Abs(fZPos[ip] - fHoughZ[ich])*csum;
+    // Step along X or Y, whichever the band is steeper in, and solve
+    // for the range of the other
+    Bool_t stepx = TMath::Abs(c5) >= TMath::Abs(c4);
+    Double_t cstep = stepx ? c4 : c5;
+    Double_t csolve = stepx ? c5 : c4;
+    if(csolve == 0.0) continue;
+    UInt_t planebit = 1U<<ip;
+    TClonesArray* hits = fPlanes[ip]->GetHits();
+    for(Int_t ihit=0;ihit<fPlanes[ip]->GetNHits();ihit++) {
+      Double_t pos = static_cast<THcDCHit*>(hits->At(ihit))->GetPos();
+      for(Int_t istep=0;istep<fHoughNBins;istep++) {
+	Double_t u = fHoughMin + (istep+0.5)*fHoughBinSize;
+	Double_t v1 = (pos - halfwidth - cstep*u)/csolve;
+	Double_t v2 = (pos + halfwidth - cstep*u)/csolve;
+	if(v1 > v2) std::swap(v1, v2);
+	// Cells with centers in [v1,v2]
+	Int_t ilo = TMath::Max(0, (Int_t) TMath::Ceil((v1-fHoughMin)/fHoughBinSize - 0.5));
+	Int_t ihi = TMath::Min(fHoughNBins-1, (Int_t) TMath::Floor((v2-fHoughMin)/fHoughBinSize - 0.5));
+	for(Int_t isolve=ilo;isolve<=ihi;isolve++) {
+	  Int_t cell = stepx ? istep*fHoughNBins + isolve : isolve*fHoughNBins + istep;
+	  if(fHoughMask[cell] == 0) fHoughTouched.push_back(cell);
+	  fHoughMask[cell] |= planebit;
+	}
+      }
+    }
+  }
+
+  // Local maxima.  Of neighbouring cells with the same count the one
+  // with the lowest index is the peak, placed at the center of the
+  // cells with that count around it.
+  for(UInt_t i=0;i<fHoughTouched.size();i++) {
+    Int_t cell = fHoughTouched[i];
+    Int_t n = CountBits(fHoughMask[cell]);
+    if(n < fMinHits[ich]) continue;
+    Int_t ix = cell/fHoughNBins;
+    Int_t iy = cell%fHoughNBins;
+    Bool_t ispeak = kTRUE;
+    Double_t sumx = 0.0, sumy = 0.0;
+    Int_t nsame = 0;
+    for(Int_t jx=TMath::Max(0,ix-1);jx<=TMath::Min(fHoughNBins-1,ix+1) && ispeak;jx++) {
+      for(Int_t jy=TMath::Max(0,iy-1);jy<=TMath::Min(fHoughNBins-1,iy+1);jy++) {
+	Int_t jcell = jx*fHoughNBins + jy;
+	Int_t nj = CountBits(fHoughMask[jcell]);
+	if(nj > n || (nj == n && jcell < cell)) {
+	  ispeak = kFALSE;
+	  break;
+	}
+	if(nj == n) {
+	  sumx += jx;
+	  sumy += jy;
+	  nsame++;
+	}
+      }
+    }
+    if(!ispeak) continue;
+    HoughPeak peak;
+    peak.x = fHoughMin + (sumx/nsame + 0.5)*fHoughBinSize;
+    peak.y = fHoughMin + (sumy/nsame + 0.5)*fHoughBinSize;
+    peak.nplanes = n;
+    // Keep the list ordered by number of planes
+    UInt_t ipos = peaks.size();
+    while(ipos > 0 && peaks[ipos-1].nplanes < n) ipos--;
+    if(ipos < (UInt_t) fHoughMaxPeaks) {
+      peaks.insert(peaks.begin()+ipos, peak);
+      if(peaks.size() > (UInt_t) fHoughMaxPeaks) peaks.pop_back();
+    }
+  }
+}
+
+//_____________________________________________________________________________
+void THcDC::HoughTracks()
+{
+  /**
+     Track finding for dc_tracking_mode 1, used instead of space points,
+     stubs and LinkStubs.
+
+     Each chamber fills a grid of the track position at its middle
+     (HoughFindPeaks).  Every pair of peaks in the two chambers gives a
+     straight line.  Lines with slopes within dc_hough_max_slope pick up
+     the hit closest to the line in each plane, within half a pitch plus
+     a grid cell.  The side of the wire the line passes is the left/right
+     choice.  Lines with enough hits become THcDCTrack candidates for
+     TrackFit, with the drift distances corrected for the propagation
+     along the wire at the line's position in each plane.  Needs
+     dc_fix_propcorr, since a hit can be on several candidates.
+
+     The cost depends on the grid size and number of hits, not on
+     combinations of hits.
+  */
+  fNSp = 0;
+  fNDCTracks = 0;
+  fDCTracks->Clear();
+
+  for(UInt_t ich=0;ich<fNChambers;ich++) {
+    HoughFindPeaks(ich);
+  }
+  Double_t dz = fHoughZ[1] - fHoughZ[0];
+  if(dz == 0.0) return;
+
+  THcDCHit* trackhits[fNPlanes];
+  Int_t tracklr[fNPlanes];
+  for(UInt_t ipeak1=0;ipeak1<fHoughPeaks[0].size();ipeak1++) {
+    const HoughPeak& peak1 = fHoughPeaks[0][ipeak1];
+    for(UInt_t ipeak2=0;ipeak2<fHoughPeaks[1].size();ipeak2++) {
+      const HoughPeak& peak2 = fHoughPeaks[1][ipeak2];
+      Double_t xp = (peak2.x - peak1.x)/dz;
+      Double_t yp = (peak2.y - peak1.y)/dz;
+      if(TMath::Abs(xp) > fHoughMaxSlope || TMath::Abs(yp) > fHoughMaxSlope) continue;
+      Double_t x = peak1.x - fHoughZ[0]*xp;
+      Double_t y = peak1.y - fHoughZ[0]*yp;
+
+      Int_t nhits = 0;
+      Int_t nchamberhits[2] = {0, 0};
+      for(Int_t ip=0;ip<fNPlanes;ip++) {
+	Double_t coord = fPlaneCoeffs[ip][4]*x + fPlaneCoeffs[ip][5]*y
+	  + fPlaneCoeffs[ip][2]*xp + fPlaneCoeffs[ip][3]*yp;
+	THcDCHit* besthit = 0;
+	Double_t bestdist = fPitch[ip]/2 + fHoughBinSize;
+	TClonesArray* hits = fPlanes[ip]->GetHits();
+	for(Int_t ihit=0;ihit<fPlanes[ip]->GetNHits();ihit++) {
+	  THcDCHit* hit = static_cast<THcDCHit*>(hits->At(ihit));
+	  Double_t dist = TMath::Abs(coord - hit->GetPos());
+	  if(dist < bestdist) {
+	    bestdist = dist;
+	    besthit = hit;
+	  }
+	}
+	if(besthit) {
+	  trackhits[nhits] = besthit;
+	  tracklr[nhits] = (coord >= besthit->GetPos()) ? 1 : -1;
+	  nhits++;
+	  nchamberhits[fNChamber[ip]-1]++;
+	}
+      }
+      if(nhits <= NUM_FPRAY) continue;
+      if(nchamberhits[0] < fMinHits[0] || nchamberhits[1] < fMinHits[1]) continue;
+
+      // Different peaks can pick up the same hits
+      Bool_t duplicate = kFALSE;
+      for(UInt_t itrack=0;itrack<fNDCTracks && !duplicate;itrack++) {
+	THcDCTrack *theDCTrack = static_cast<THcDCTrack*>( fDCTracks->At(itrack));
+	if(theDCTrack->GetNHits() != nhits) continue;
+	duplicate = kTRUE;
+	for(Int_t ihit=0;ihit<nhits;ihit++) {
+	  if(theDCTrack->GetHit(ihit) != trackhits[ihit]
+	     || theDCTrack->GetHitLR(ihit) != tracklr[ihit]) {
+	    duplicate = kFALSE;
+	    break;
+	  }
+	}
+      }
+      if(duplicate) continue;
+
+      if(fNDCTracks >= MAXTRACKS) {
+	if (fdebuglinkstubs) cout << "Too many tracks found in THcDC::HoughTracks maxtracks = " << MAXTRACKS << endl;
+	return;
+      }
+      THcDCTrack *theDCTrack = AddDCTrack();
+      theDCTrack->SetSp1_ID(-1);
+      theDCTrack->SetSp2_ID(-1);
+      // Correct for the propagation along the wire with the line's
+      // position at each plane, as CorrectHitTimes does with the space
+      // point position
+      for(Int_t ihit=0;ihit<nhits;ihit++) {
+	THcDCHit* hit = trackhits[ihit];
+	Int_t ip = hit->GetPlaneNum()-1;
+	Double_t dist = fChambers[fNChamber[ip]-1]->CorrectedHitDist(hit,
+	  x + xp*fZPos[ip], y + yp*fZPos[ip]);
+	hit->SetLeftRight(tracklr[ihit]);
+	theDCTrack->AddHit(hit, dist, tracklr[ihit]);
+      }
+    }
+  }
+  if (fdebuglinkstubs) {
+    cout << " Number of tracks from Hough = " << fNDCTracks << endl;
+  }
+}
+
+//_____________________________________________________________________________
+static Bool_t InvertSymmetric4(const Double_t AA[NUM_FPRAY][NUM_FPRAY],
+			       Double_t AAinv[NUM_FPRAY][NUM_FPRAY])
+{
+  /// Invert a symmetric positive definite matrix by Cholesky
+  /// decomposition.  Returns kFALSE if it is not positive definite.
+  Double_t L[NUM_FPRAY][NUM_FPRAY];
+  for(Int_t i=0;i<NUM_FPRAY;i++) {
+    for(Int_t j=0;j<=i;j++) {
+      Double_t sum = AA[i][j];
+      for(Int_t k=0;k<j;k++) sum -= L[i][k]*L[j][k];
+      if(i == j) {
+	if(sum <= 0.0) return kFALSE;
+	L[i][i] = TMath::Sqrt(sum);
+      } else {
+	L[i][j] = sum/L[j][j];
+      }
+    }
+  }
+  // Linv = L^-1, lower triangular
+  Double_t Linv[NUM_FPRAY][NUM_FPRAY];
+  for(Int_t i=0;i<NUM_FPRAY;i++) {
+    for(Int_t j=0;j<NUM_FPRAY;j++) Linv[i][j] = 0.0;
+    Linv[i][i] = 1.0/L[i][i];
+    for(Int_t j=0;j<i;j++) {
+      Double_t sum = 0.0;
+      for(Int_t k=j;k<i;k++) sum -= L[i][k]*Linv[k][j];
+      Linv[i][j] = sum/L[i][i];
+    }
+  }
+  // AA^-1 = Linv^T Linv
+  for(Int_t i=0;i<NUM_FPRAY;i++) {
+    for(Int_t j=i;j<NUM_FPRAY;j++) {
+      Double_t sum = 0.0;
+      for(Int_t k=j;k<NUM_FPRAY;k++) sum += Linv[k][i]*Linv[k][j];
+      AAinv[i][j] = sum;
+      AAinv[j][i] = sum;
+    }
+  }
+  return kTRUE;
+}
+
 //_____________________________________________________________________________
 void THcDC::TrackFit()
 {
@@ -971,54 +1392,46 @@ void THcDC::TrackFit()
 
     theDCTrack->SetNFree(theDCTrack->GetNHits() - NUM_FPRAY);
     Double_t chi2 = dummychi2;
+    Double_t TT[NUM_FPRAY];
+    Double_t AAinv[NUM_FPRAY][NUM_FPRAY];
+    Bool_t fitok = kFALSE;
     if(theDCTrack->GetNFree() > 0) {
-      TVectorD TT(NUM_FPRAY);
-      TMatrixD AA(NUM_FPRAY,NUM_FPRAY);
+      Double_t AA[NUM_FPRAY][NUM_FPRAY];
       for(Int_t irayp=0;irayp<NUM_FPRAY;irayp++) {
 	TT[irayp] = 0.0;
-	for(Int_t ihit=0;ihit < theDCTrack->GetNHits();ihit++) {	
-
-	  THcDCHit* hit=theDCTrack->GetHit(ihit);
-	    
-	  TT[irayp] += (coords[ihit]*fPlaneCoeffs[planes[ihit]][raycoeffmap[irayp]])/pow(hit->GetWireSigma(),2);
-	  //	  if (hit->GetPlaneNum()==5)
-	  //	    {
-	  //	      //	cout << "Plane: " << hit->GetPlaneNum() << endl;
-	  //	      //cout << "Wire: " <<hit->GetWireNum() << endl;
-	  //	      //cout << "Sigma: " << hit->GetWireSigma() << endl;
-	  //	    }
-
-	} //end hit loop
-      }
-      for(Int_t irayp=0;irayp<NUM_FPRAY;irayp++) {
 	for(Int_t jrayp=0;jrayp<NUM_FPRAY;jrayp++) {
 	  AA[irayp][jrayp] = 0.0;
-	  if(jrayp<irayp) { // Symmetric
-	    AA[irayp][jrayp] = AA[jrayp][irayp];
-	  } else {
-	    for(Int_t ihit=0;ihit < theDCTrack->GetNHits();ihit++) {
-
-	      THcDCHit* hit=theDCTrack->GetHit(ihit);
-        
-		      
-	      AA[irayp][jrayp] += fPlaneCoeffs[planes[ihit]][raycoeffmap[irayp]]*
-		fPlaneCoeffs[planes[ihit]][raycoeffmap[jrayp]]/
-		pow(hit->GetWireSigma(),2);
-
-	    } //end ihit loop
+	}
+      }
+      for(Int_t ihit=0;ihit < theDCTrack->GetNHits();ihit++) {
+	THcDCHit* hit=theDCTrack->GetHit(ihit);
+	Double_t sigma2 = pow(hit->GetWireSigma(),2);
+	for(Int_t irayp=0;irayp<NUM_FPRAY;irayp++) {
+	  Double_t coef = fPlaneCoeffs[planes[ihit]][raycoeffmap[irayp]];
+	  TT[irayp] += (coords[ihit]*coef)/sigma2;
+	  for(Int_t jrayp=irayp;jrayp<NUM_FPRAY;jrayp++) { // Symmetric
+	    AA[irayp][jrayp] += coef*fPlaneCoeffs[planes[ihit]][raycoeffmap[jrayp]]/sigma2;
 	  }
 	}
+      } //end hit loop
+      for(Int_t irayp=0;irayp<NUM_FPRAY;irayp++) {
+	for(Int_t jrayp=0;jrayp<irayp;jrayp++) {
+	  AA[irayp][jrayp] = AA[jrayp][irayp];
+	}
       }
 
       // Solve 4x4 equations
-      TVectorD dray(NUM_FPRAY);
-      // Should check that it is invertable
-      AA.Invert();
-      dray = AA*TT;
+      fitok = InvertSymmetric4(AA, AAinv);
+    }
+    if(fitok) {
+      Double_t dray[NUM_FPRAY];
+      for(Int_t irayp=0;irayp<NUM_FPRAY;irayp++) {
+	dray[irayp] = 0.0;
+	for(Int_t jrayp=0;jrayp<NUM_FPRAY;jrayp++) {
+	  dray[irayp] += AAinv[irayp][jrayp]*TT[jrayp];
+	}
+      }
       //      cout << "DRAY: " << dray[0] << " "<< dray[1] << " "<< dray[2] << " "<< dray[3] << " "  << endl;
-      //      if(bad_determinant) {
-      //	dray[0] = dray[1] = 10000.; dray[2] = dray[3] = 2.0;
-      //      }
       // Calculate hit coordinate for each plane for chi2 and efficiency
       // calculations
 
@@ -1048,68 +1461,30 @@ void THcDC::TrackFit()
       }
 
       theDCTrack->SetVector(dray[0], dray[1], 0.0, dray[2], dray[3]);
-    }
-    theDCTrack->SetChisq(chi2);
-
-    // calculate ray without a plane in track
-    for(Int_t ipl_hit=0;ipl_hit < theDCTrack->GetNHits();ipl_hit++) {    
- 
 
-      if(theDCTrack->GetNFree() > 0) {
-	TVectorD TT(NUM_FPRAY);
-	TMatrixD AA(NUM_FPRAY,NUM_FPRAY);
-	for(Int_t irayp=0;irayp<NUM_FPRAY;irayp++) {
-	  TT[irayp] = 0.0;
-	  for(Int_t ihit=0;ihit < theDCTrack->GetNHits();ihit++) {
-	  
-
-	    THcDCHit* hit=theDCTrack->GetHit(ihit);
-
-	    if (ihit != ipl_hit) {
-	      TT[irayp] += (coords[ihit]*
-			    fPlaneCoeffs[planes[ihit]][raycoeffmap[irayp]])
-		/pow(hit->GetWireSigma(),2);
-
-	    }
-	  }
-	}
+      // Calculate ray without a plane in track.  Removing hit i takes
+      // a_i*a_i^T out of AA, with a_i the plane coefficients over sigma.
+      // By Sherman-Morrison the refit moves the hit's residual r_i to
+      // r_i/(1-h_i), with h_i = a_i^T AA^-1 a_i, so no matrix has to be
+      // inverted again.
+      for(Int_t ipl_hit=0;ipl_hit < theDCTrack->GetNHits();ipl_hit++) {
+	THcDCHit* hit=theDCTrack->GetHit(ipl_hit);
+	Double_t sigma2 = pow(hit->GetWireSigma(),2);
+	Double_t hii = 0.0;
 	for(Int_t irayp=0;irayp<NUM_FPRAY;irayp++) {
 	  for(Int_t jrayp=0;jrayp<NUM_FPRAY;jrayp++) {
-	    AA[irayp][jrayp] = 0.0;
-	    if(jrayp<irayp) { // Symmetric
-	      AA[irayp][jrayp] = AA[jrayp][irayp];
-	    } else {
-
-	      for(Int_t ihit=0;ihit < theDCTrack->GetNHits();ihit++) {
-	      
-		THcDCHit* hit=theDCTrack->GetHit(ihit);
-
-
-		if (ihit != ipl_hit) {
-		  AA[irayp][jrayp] += fPlaneCoeffs[planes[ihit]][raycoeffmap[irayp]]*
-		    fPlaneCoeffs[planes[ihit]][raycoeffmap[jrayp]]/
-		    pow(hit->GetWireSigma(),2);
-
-		}
-	      }
-	    }
+	    hii += fPlaneCoeffs[planes[ipl_hit]][raycoeffmap[irayp]]*AAinv[irayp][jrayp]
+	      *fPlaneCoeffs[planes[ipl_hit]][raycoeffmap[jrayp]];
 	  }
 	}
-	//
-	// Solve 4x4 equations
-	// Should check that it is invertable
-	TVectorD dray(NUM_FPRAY);
-	AA.Invert();
-	dray = AA*TT;
-	Double_t coord=0.0;
-	for(Int_t ir=0;ir<NUM_FPRAY;ir++) {
-	  coord += fPlaneCoeffs[planes[ipl_hit]][raycoeffmap[ir]]*dray[ir];
-	  // cout << "ir = " << ir << ", dray[ir] = " << dray[ir] << endl;
+	hii /= sigma2;
+	if(1.0 - hii > 1.0e-10) { // Otherwise the track is undetermined without this hit
+	  Double_t residual = coords[ipl_hit] - theDCTrack->GetCoord(planes[ipl_hit]);
+	  theDCTrack->SetResidualExclPlane(planes[ipl_hit], residual/(1.0 - hii));
 	}
-	Double_t residual = coords[ipl_hit] - coord;
-	theDCTrack->SetResidualExclPlane(planes[ipl_hit], residual);
       }
     }
+    theDCTrack->SetChisq(chi2);
   }
   //Calculate residual without plane
 
@@ -1294,6 +1669,7 @@ void THcDC::EffInit()
 
   delete [] fNChamHits; fNChamHits = new Int_t [fNChambers];
   delete [] fPlaneEvents; fPlaneEvents = new Int_t [fNPlanes];
+  delete [] fMaskedHits; fMaskedHits = new Int_t [fNPlanes];
 
   fTotEvents = 0;
   for(UInt_t i=0;i<fNChambers;i++) {
@@ -1301,10 +1677,12 @@ void THcDC::EffInit()
   }
   for(Int_t i=0;i<fNPlanes;i++) {
     fPlaneEvents[i] = 0;
+    fMaskedHits[i] = 0;
   }
   gHcParms->Define(Form("%sdc_tot_events",fPrefix),"Total DC Events",fTotEvents);
   gHcParms->Define(Form("%sdc_cham_hits[%d]",fPrefix,fNChambers),"N events with hits per chamber",*fNChamHits);
   gHcParms->Define(Form("%sdc_events[%d]",fPrefix,fNPlanes),"N events with hits per plane",*fPlaneEvents);
+  gHcParms->Define(Form("%sdc_masked_hits[%d]",fPrefix,fNPlanes),"N TDC hits on masked wires per plane",*fMaskedHits);
 }
 
 //_____________________________________________________________________________
@@ -1320,6 +1698,7 @@ void THcDC::Eff()
   }
   for(Int_t i=0;i<fNPlanes;i++) {
     if(fPlanes[i]->GetNHits() > 0) fPlaneEvents[i]++;
+    fMaskedHits[i] += fPlanes[i]->GetNMaskedHits();
   }
   return;
 }
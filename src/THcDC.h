@@ -13,6 +13,7 @@
 #include "THcSpacePoint.h"
 #include "THcDriftChamberPlane.h"
 #include "THcDriftChamber.h"
+#include "THcDCTrack.h"
 #include "TMath.h"
 
 #define NUM_FPRAY 4
@@ -34,6 +35,7 @@ public:
   virtual Int_t      FineTrack( TClonesArray& tracks );
 
   virtual Int_t      ApplyCorrections( void );
+  Int_t              LoadRawHits( TClonesArray* rawhits );
 
   //  Int_t GetNHits() const { return fNhit; }
 
@@ -73,6 +75,21 @@ public:
 
   Double_t GetNSperChan() const { return fNSperChan;}
 
+  Int_t GetMaskDeadWires() const { return fMaskDeadWires;}
+  Int_t GetNDeadWires() const { return fDeadWirePlane.size();}
+  Int_t GetDeadWirePlane(Int_t i) const { return fDeadWirePlane[i];}
+  Int_t GetDeadWireNum(Int_t i) const { return fDeadWireNum[i];}
+  Double_t GetHotWireOccupancy() const { return fHotWireOccupancy;}
+  Int_t GetHotWireNEvents() const { return fHotWireNEvents;}
+
+  Int_t GetNPlanes() const { return fNPlanes;}
+  UInt_t GetNChambers() const { return fNChambers;}
+  THcDriftChamberPlane* GetPlane(Int_t plane) const { return fPlanes[plane-1];}
+  UInt_t GetNDCTracks() const { return fNDCTracks;}
+  THcDCTrack* GetDCTrack(UInt_t itrack) const
+  { return static_cast<THcDCTrack*>(fDCTracks->At(itrack));}
+  Double_t DpsiFun(Double_t ray[4], Int_t plane);
+
   Double_t GetCenter(Int_t plane) const {
     return
       //fXCenter[chamber]*sin(fAlphaAngle[plane-1]) +
@@ -128,6 +145,17 @@ protected:
   Double_t fNSperChan;		/* TDC bin size */
   Double_t fWireVelocity;
   Int_t fSingleStub;		/* If 1, single stubs make tracks */
+  Int_t fParallelChambers;	/* If 1, find stubs of the chambers in parallel */
+  Int_t fTrackingMode;		/* 0: space points and stubs, 1: Hough */
+  Double_t fHoughBinSize;	/* Hough cell size (cm) */
+  Int_t fHoughMaxPeaks;		/* Most Hough peaks used per chamber */
+  Double_t fHoughMaxSlope;	/* Largest x' and y' of Hough tracks */
+  Int_t fMaskDeadWires;		/* If 1, drop hits on the dead wires */
+  std::vector<Int_t> fDeadWirePlane; /* Plane and wire number of dead wires */
+  std::vector<Int_t> fDeadWireNum;
+  Double_t fHotWireOccupancy;	/* Mask wires hit in more than this fraction
+				   of events, 0 for none */
+  Int_t fHotWireNEvents;	/* Events between hot wire checks */
   Int_t fNTracksMaxFP;
   Double_t fXtTrCriterion;
   Double_t fYtTrCriterion;
@@ -180,6 +208,7 @@ protected:
   Int_t fTotEvents;
   Int_t* fNChamHits;
   Int_t* fPlaneEvents;
+  Int_t* fMaskedHits;		// TDC hits on masked wires per plane
 
   // Pointer to global var indicating whether this spectrometer is triggered
   // for this event.
@@ -194,15 +223,36 @@ protected:
   std::vector<THcDriftChamberPlane*> fPlanes; // List of plane objects
   std::vector<THcDriftChamber*> fChambers; // List of chamber objects
 
+  // LinkStubs work space, kept between events
+  std::vector<THcSpacePoint*> fSp;	// Space points of both chambers
+  std::vector<std::pair<Double_t,Int_t> > fSpByX; // Stub x and index in fSp
+  std::vector<Int_t> fLinkCandidates;
+
+  // Hough tracking.  Each chamber votes in a grid of the track position
+  // (X,Y) at the middle of the chamber.
+  struct HoughPeak {
+    Double_t x, y;		// Position at the middle of the chamber
+    Int_t nplanes;		// Planes voting
+  };
+  Int_t fHoughNBins;		// Grid cells per axis
+  Double_t fHoughMin;		// Lower edge of the grid in X and Y
+  std::vector<Double_t> fHoughZ;	// Middle z of each chamber
+  std::vector<UInt_t> fHoughMask;	// Bit pattern of planes voting per cell
+  std::vector<Int_t> fHoughTouched;	// Cells with votes
+  std::vector<std::vector<HoughPeak> > fHoughPeaks; // Peaks of each chamber
+
   TClonesArray*  fTrackProj;  // projection of track onto scintillator plane
                               // and estimated match to TOF paddle
   void           ClearEvent();
+  void           LoadPlaneHits( TClonesArray* rawhits, Bool_t process );
   void           DeleteArrays();
   virtual Int_t  ReadDatabase( const TDatime& date );
   virtual Int_t  DefineVariables( EMode mode = kDefine );
   void           LinkStubs();
+  THcDCTrack*    AddDCTrack();
+  void           HoughTracks();
+  void           HoughFindPeaks(UInt_t ich);
   void           TrackFit();
-  Double_t       DpsiFun(Double_t ray[4], Int_t plane);
   void           EffInit();
   void           Eff();
 
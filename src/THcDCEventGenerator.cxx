@@ -0,0 +1,163 @@
+/** \class THcDCEventGenerator
+    \ingroup DetSupport
+
+\brief Drift chamber hits from straight tracks, for tracking studies
+
+Makes THcRawDCHit lists for an initialized THcDC without an EVIO file.
+Each event has one straight track, uniform in x, y, x' and y' at the
+focal plane within the range given with SetRayRange.  The track is
+projected to every plane with the plane coefficients of the chambers
+(THcDC::DpsiFun), so the geometry is the one from the dc parameter
+file.  In each plane the closest wire gets a hit:
+
+- The plane misses the track with the chance set by SetInefficiency.
+- The drift distance is smeared with a gaussian of SetDriftSmearing
+  and turned into a drift time by inverting the time to distance
+  conversion of the wire, so the drift map is used.
+- The time becomes a raw TDC value with the plane time zero, wire time
+  offset and TDC bin size that THcDriftChamberPlane::ProcessHits uses.
+
+Noise hits are added with a chance of SetNoise per wire and event, at
+a TDC value uniform in the TDC window.  Propagation along the wire and
+the hodoscope start time are not simulated.
+
+The list goes to THcDC::LoadRawHits in place of Decode, then to
+THcDC::CoarseTrack:
+
+    gen->Generate(rawhits);
+    dc->LoadRawHits(rawhits);
+    dc->CoarseTrack(tracks);
+
+examples/dcsimbench.C uses this to time the tracking and plot the
+residuals.
+
+*/
+#include "THcDCEventGenerator.h"
+#include "THcDC.h"
+#include "THcDriftChamberPlane.h"
+#include "THcDCWire.h"
+#include "THcDCTimeToDistConv.h"
+#include "THcRawDCHit.h"
+#include "TClonesArray.h"
+#include "TMath.h"
+
+#include <algorithm>
+
+using namespace std;
+
+THcDCEventGenerator::THcDCEventGenerator(THcDC* dc, UInt_t seed) :
+  fDC(dc), fRandom(seed), fNoise(0.0), fIneff(0.0), fSmear(0.0),
+  fNTrueHits(0)
+{
+  /// Normal constructor.  dc must be initialized.
+  SetRayRange(30.0, 15.0, 0.05, 0.03);
+  for(Int_t i=0; i<4; i++) fRay[i] = 0.0;
+}
+
+THcDCEventGenerator::~THcDCEventGenerator()
+{
+  /// Destructor
+}
+
+void THcDCEventGenerator::SetRayRange(Double_t xmax, Double_t ymax,
+				      Double_t xpmax, Double_t ypmax)
+{
+  /// Tracks are uniform in -xmax..xmax etc. at the focal plane (cm)
+  fRayMax[0] = xmax;
+  fRayMax[1] = ymax;
+  fRayMax[2] = xpmax;
+  fRayMax[3] = ypmax;
+}
+
+Int_t THcDCEventGenerator::Generate(TClonesArray* rawhits)
+{
+  /**
+\brief Make the raw hits of one event
+
+\param[out] rawhits TClonesArray of THcRawDCHit, sorted by plane and wire
+\return Number of raw hits
+  */
+  rawhits->Clear();
+  fArena.Clear();
+  fHits.clear();
+  fNTrueHits = 0;
+
+  for(Int_t i=0; i<4; i++) {
+    fRay[i] = fRayMax[i]*(2*fRandom.Rndm() - 1);
+  }
+
+  for(Int_t ip=1; ip<=fDC->GetNPlanes(); ip++) {
+    THcDriftChamberPlane* plane = fDC->GetPlane(ip);
+    Int_t nwires = plane->GetNWires();
+
+    Double_t pos = fDC->DpsiFun(fRay, ip-1);
+    Int_t wirenum = TMath::Nint(plane->CalcWireFromPos(pos));
+    if(wirenum >= 1 && wirenum <= nwires && fRandom.Rndm() >= fIneff) {
+      THcDCWire* wire = plane->GetWire(wirenum);
+      Double_t dist = TMath::Abs(pos - wire->GetPos());
+      if(fSmear > 0) dist = TMath::Abs(dist + fRandom.Gaus(0.0, fSmear));
+      GenHit hit;
+      hit.plane = ip;
+      hit.wire = wirenum;
+      hit.tdc = TimeToTdc(ip, wire, DriftTime(ip, wire, dist));
+      fHits.push_back(hit);
+      fNTrueHits++;
+    }
+
+    Int_t nnoise = fNoise > 0 ? (Int_t) fRandom.Poisson(fNoise*nwires) : 0;
+    Int_t winmin = fDC->GetTdcWinMin(ip);
+    Int_t winmax = fDC->GetTdcWinMax(ip);
+    for(Int_t i=0; i<nnoise; i++) {
+      GenHit hit;
+      hit.plane = ip;
+      hit.wire = 1 + fRandom.Integer(nwires);
+      hit.tdc = winmin + fRandom.Integer(winmax - winmin + 1);
+      fHits.push_back(hit);
+    }
+  }
+
+  // One raw hit per wire.  The track hit stays in front of noise on
+  // the same wire.
+  stable_sort(fHits.begin(), fHits.end());
+  Int_t nraw = 0;
+  THcRawDCHit* rawhit = 0;
+  for(UInt_t i=0; i<fHits.size(); i++) {
+    if(i == 0 || fHits[i-1] < fHits[i]) {
+      rawhit = new( (*rawhits)[nraw++] ) THcRawDCHit(fHits[i].plane, fHits[i].wire);
+      rawhit->SetArena(&fArena);
+    }
+    rawhit->SetData(0, fHits[i].tdc);
+  }
+  return nraw;
+}
+
+Double_t THcDCEventGenerator::DriftTime(Int_t plane, THcDCWire* wire,
+					Double_t dist)
+{
+  /// Drift time for a drift distance, by bisection of the time to
+  /// distance conversion of the wire over the TDC window
+  THcDCTimeToDistConv* ttd = wire->GetTTDConv();
+  Double_t t0 = fDC->GetPlaneTimeZero(plane) - wire->GetTOffset();
+  Double_t tlo = t0 - fDC->GetTdcWinMax(plane)*fDC->GetNSperChan();
+  Double_t thi = t0 - fDC->GetTdcWinMin(plane)*fDC->GetNSperChan();
+  if(tlo > thi) swap(tlo, thi);
+  for(Int_t i=0; i<40; i++) {
+    Double_t t = (tlo + thi)/2;
+    if(ttd->ConvertTimeToDist(t) < dist) {
+      tlo = t;
+    } else {
+      thi = t;
+    }
+  }
+  return (tlo + thi)/2;
+}
+
+Int_t THcDCEventGenerator::TimeToTdc(Int_t plane, THcDCWire* wire,
+				     Double_t time)
+{
+  /// Raw TDC value that THcDriftChamberPlane::ProcessHits turns into time
+  return TMath::Nint((fDC->GetPlaneTimeZero(plane) - wire->GetTOffset() - time)
+		     /fDC->GetNSperChan());
+}
+
+ClassImp(THcDCEventGenerator)
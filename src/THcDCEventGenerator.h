@@ -0,0 +1,67 @@
+#ifndef ROOT_THcDCEventGenerator
+#define ROOT_THcDCEventGenerator
+
+//////////////////////////////////////////////////////////////////////////
+//
+// THcDCEventGenerator
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "TObject.h"
+#include "TRandom3.h"
+#include "THcRawDataArena.h"
+
+#include <vector>
+
+class THcDC;
+class THcDCWire;
+class TClonesArray;
+
+class THcDCEventGenerator : public TObject {
+
+public:
+
+  THcDCEventGenerator(THcDC* dc, UInt_t seed=0);
+  virtual ~THcDCEventGenerator();
+
+  void  SetRayRange(Double_t xmax, Double_t ymax, Double_t xpmax, Double_t ypmax);
+  void  SetNoise(Double_t occupancy) { fNoise = occupancy; }
+  void  SetInefficiency(Double_t ineff) { fIneff = ineff; }
+  void  SetDriftSmearing(Double_t sigma) { fSmear = sigma; }
+
+  Int_t Generate(TClonesArray* rawhits);
+
+  void  GetRay(Double_t* ray) const
+  { ray[0]=fRay[0]; ray[1]=fRay[1]; ray[2]=fRay[2]; ray[3]=fRay[3]; }
+  Int_t GetNTrueHits() const { return fNTrueHits; }
+
+protected:
+
+  struct GenHit {		// One TDC hit before it goes into a raw hit
+    Int_t plane;
+    Int_t wire;
+    Int_t tdc;
+    Bool_t operator<(const GenHit& rhs) const {
+      return plane < rhs.plane || (plane == rhs.plane && wire < rhs.wire);
+    }
+  };
+
+  Double_t DriftTime(Int_t plane, THcDCWire* wire, Double_t dist);
+  Int_t    TimeToTdc(Int_t plane, THcDCWire* wire, Double_t time);
+
+  THcDC* fDC;
+  TRandom3 fRandom;
+  Double_t fRayMax[4];		// Ray is uniform in +-fRayMax
+  Double_t fNoise;		// Chance of a noise hit per wire and event
+  Double_t fIneff;		// Chance of a plane missing the track
+  Double_t fSmear;		// Sigma of the drift distance (cm)
+
+  Double_t fRay[4];		// x, y, x', y' of the last track
+  Int_t fNTrueHits;		// Planes hit by the last track
+
+  std::vector<GenHit> fHits;
+  THcRawDataArena fArena;	// TDC values of the raw hits
+
+  ClassDef(THcDCEventGenerator,0);  // Drift chamber hits from straight tracks
+};
+#endif
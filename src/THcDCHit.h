@@ -20,7 +20,8 @@ public:
     THcDriftChamberPlane* wp=0) :
     fWire(wire), fRawNoRefCorrTime(rawnorefcorrtime), fRawTime(rawtime), fTime(time), fWirePlane(wp),
       fDist(0.0), fLR(0), ftrDist(kBig) {
-      if (wire) ConvertTimeToDist();
+      // Drift distance is filled once the start time is known, by
+      // THcDriftChamberPlane::SubtractStartTime
       fCorrected = 0;
     }
   virtual ~THcDCHit() {}
@@ -22,6 +22,14 @@ fT0(T0), fMaxDriftDistance(MaxDriftDistance), fBinSize(BinSize),
   assert( fNumBins > 0 );
   fTable = new Double_t[fNumBins];
   memcpy( fTable, Table, fNumBins*sizeof(Double_t) );
+
+  // Float copy for ConvertTimesToDists.  The padding bin means bin ib+1
+  // can be read for every bin in range without a check.
+  fFloatTable = new Float_t[fNumBins+1];
+  for(Int_t ib=0;ib<fNumBins;ib++) {
+    fFloatTable[ib] = fTable[ib];
+  }
+  fFloatTable[fNumBins] = 1.0;
 }
 
 //______________________________________________________________________________
@@ -30,6 +38,7 @@ THcDCLookupTTDConv::~THcDCLookupTTDConv()
   // Destructor
 
   delete [] fTable;
+  delete [] fFloatTable;
 }
 
 //______________________________________________________________________________
@@ -53,4 +62,27 @@ Double_t THcDCLookupTTDConv::ConvertTimeToDist(Double_t time)
   return(drift_distance);
 }
 
+//______________________________________________________________________________
+void THcDCLookupTTDConv::ConvertTimesToDists(Int_t n, const Double_t* times,
+					     Double_t* dists)
+{
+  /**
+     Convert n drift times to distances with the float table.  The bins
+     outside the table are handled by selecting the result instead of
+     branching, so the loop body is the same for every time and the
+     compiler can vectorize it.  Same as ConvertTimeToDist up to the
+     float rounding of the table.
+  */
+  const Int_t lastbin = fNumBins-1;
+  for(Int_t i=0;i<n;i++) {
+    Int_t ib = (times[i]-fT0)/fBinSize;
+    Int_t ibc = ib < 0 ? 0 : (ib > lastbin ? lastbin : ib);
+    Double_t tfrac = (times[i] - (ibc*fBinSize + fT0)) / fBinSize;
+    Double_t frac = fFloatTable[ibc]*(1-tfrac) + fFloatTable[ibc+1]*tfrac;
+    frac = ib+1 >= fNumBins ? 1.0 : frac;
+    frac = ib < 0 ? 0.0 : frac;
+    dists[i] = fMaxDriftDistance * frac;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
@@ -19,6 +19,8 @@ public:
   virtual ~THcDCLookupTTDConv();
 
   virtual Double_t ConvertTimeToDist(Double_t time);
+  virtual void     ConvertTimesToDists(Int_t n, const Double_t* times,
+				       Double_t* dists);
 
 
 protected:
@@ -28,6 +30,7 @@ protected:
   Double_t fBinSize;
   Int_t fNumBins;
   Double_t* fTable;
+  Float_t* fFloatTable;		// fTable with one extra bin of 1.0 at the end
 
   ClassDef(THcDCLookupTTDConv,0)             // Time to Distance conversion lookup
 };
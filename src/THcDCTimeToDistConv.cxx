@@ -17,5 +17,17 @@ THcDCTimeToDistConv::~THcDCTimeToDistConv()
 
 }
 
+//______________________________________________________________________________
+void THcDCTimeToDistConv::ConvertTimesToDists(Int_t n, const Double_t* times,
+					      Double_t* dists)
+{
+  /**
+     Convert n drift times to distances.  Algorithms that can do better
+     than one ConvertTimeToDist call per time should override this.
+  */
+  for(Int_t i=0;i<n;i++) {
+    dists[i] = ConvertTimeToDist(times[i]);
+  }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
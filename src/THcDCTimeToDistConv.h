@@ -18,6 +18,8 @@ public:
   virtual ~THcDCTimeToDistConv();
 
   virtual Double_t ConvertTimeToDist(Double_t time) = 0;
+  virtual void     ConvertTimesToDists(Int_t n, const Double_t* times,
+				       Double_t* dists);
 
 private:
 
@@ -11,10 +11,19 @@
 THcDCTrack::THcDCTrack(Int_t nplanes) : fnSP(0), fNHits(0)
 {
   fHits.clear();
-  fCoords.resize(nplanes);
-  fResiduals.resize(nplanes);
-  fResidualsExclPlane.resize(nplanes);
-  fDoubleResiduals.resize(nplanes);
+  SetNPlanes(nplanes);
+}
+
+void THcDCTrack::SetNPlanes(Int_t nplanes)
+{
+  /**
+     Size the per-plane arrays and set them to zero.  Tracks are reused
+     from event to event, so this allocates only the first time.
+  */
+  fCoords.assign(nplanes, 0.0);
+  fResiduals.assign(nplanes, 0.0);
+  fResidualsExclPlane.assign(nplanes, 0.0);
+  fDoubleResiduals.assign(nplanes, 0.0);
 }
 
 void THcDCTrack::AddHit(THcDCHit * hit, Double_t dist, Int_t lr)
@@ -19,10 +19,11 @@ class THcDCHit;
 class THcDCTrack : public TObject {
 
 public:
-  THcDCTrack(Int_t nplanes);
+  THcDCTrack(Int_t nplanes=0);
   virtual ~THcDCTrack() {};
 
   virtual void AddSpacePoint(THcSpacePoint* sp);
+  virtual void AddHit(THcDCHit * hit, Double_t dist, Int_t lr);
 
   //Get and Set Functions
   //  Int_t* GetSpacePoints()               {return fspID;}
@@ -58,6 +59,7 @@ public:
   void SetSp2_ID(Int_t isp2) {fSp2_ID= isp2;}
 
   virtual void ClearHits( );
+  void SetNPlanes(Int_t nplanes);
 
   // TObject functions redefined
   virtual void Clear( Option_t* opt="" );
@@ -86,8 +88,6 @@ protected:
   Double_t fXp_fp, fYp_fp;
   Double_t fChi2_fp;
 
-  virtual void AddHit(THcDCHit * hit, Double_t dist, Int_t lr);
-
 private:
   // Hide copy ctor and op=
   THcDCTrack( const THcDCTrack& );
@@ -0,0 +1,176 @@
+/** \class THcDiagnostics
+    \ingroup Base
+
+\brief Rate-limited collection of warnings from the event loop
+
+Warnings that can happen in every event, such as missing reference
+times, are not printed when they happen.  Each kind of warning is
+registered once with a key and is counted every time it happens.  Only
+a sample of the messages is kept: the first `nfirst`, then every
+`every`'th.  Kept messages go into a fixed size ring buffer, so a
+warning that fires in every event costs a counter increment, and
+memory use is bounded.
+
+The counts and the buffered messages are printed by Flush, which
+THcAnalyzer calls at the end of the analysis.  The count of each kind
+of warning is also available in gHcParms as `gen_diag_<key>`, so it
+can be used in report templates.  THcAnalyzer calls Reset at the start
+of the analysis, so the counts are those of the current run.
+
+The usual pattern is to format the message only if it is kept:
+
+    if(gHcDiagnostics->Count(fDiagType)) {
+      gHcDiagnostics->Keep(fDiagType, Form("... %d", ...));
+    }
+
+A single instance, gHcDiagnostics, is shared by all classes.
+
+*/
+#include "THcDiagnostics.h"
+#include "THcGlobals.h"
+#include "THcParmList.h"
+
+#include <iostream>
+#include <iomanip>
+
+using namespace std;
+
+THcDiagnostics::THcDiagnostics(UInt_t nkeep) :
+  fNext(0), fNKept(0), fNLost(0)
+{
+  /// Normal constructor.  At most nkeep messages are buffered.
+  fBuffer.resize(nkeep > 0 ? nkeep : 1);
+}
+
+THcDiagnostics::~THcDiagnostics()
+{
+  /// Destructor.  Prints messages not flushed yet.
+  if(fNKept > 0) Flush();
+  for(UInt_t i=0; i<fTypes.size(); i++) {
+    if(gHcParms) gHcParms->RemoveName(Form("gen_diag_%s", fTypes[i]->key.Data()));
+    delete fTypes[i];
+  }
+}
+
+Int_t THcDiagnostics::Register(const char* key, const char* description,
+			       UInt_t nfirst, UInt_t every)
+{
+  /**
+\brief Add a kind of message
+
+\param[in] key Name of the message type, used in `gen_diag_<key>`
+\param[in] description Printed with the count
+\param[in] nfirst Number of messages kept from the start
+\param[in] every After the first nfirst, keep every every'th message.
+           0 keeps no more.
+\return Type number for Count and Keep.  Registering a key again
+        returns the number it got the first time.
+  */
+  Int_t type = GetType(key);
+  if(type >= 0) return type;
+
+  MessageType* t = new MessageType;
+  t->key = key;
+  t->description = description;
+  t->nfirst = nfirst;
+  t->every = every;
+  t->count = 0;
+  t->kept = 0;
+  fTypes.push_back(t);
+  if(gHcParms) {
+    gHcParms->Define(Form("gen_diag_%s", key), description, t->count);
+  }
+  return fTypes.size()-1;
+}
+
+Int_t THcDiagnostics::GetType(const char* key) const
+{
+  /// Type number of a key, -1 if not registered
+  for(UInt_t i=0; i<fTypes.size(); i++) {
+    if(fTypes[i]->key == key) return i;
+  }
+  return -1;
+}
+
+UInt_t THcDiagnostics::GetCount(Int_t type) const
+{
+  /// Number of messages of a type so far
+  if(type < 0 || (UInt_t) type >= fTypes.size()) return 0;
+  return fTypes[type]->count;
+}
+
+Bool_t THcDiagnostics::Count(Int_t type)
+{
+  /**
+\brief Count one message of a type
+
+\return kTRUE if this message should be kept with Keep
+  */
+  if(type < 0 || (UInt_t) type >= fTypes.size()) return kFALSE;
+  MessageType* t = fTypes[type];
+  UInt_t n = ++t->count;
+  if(n <= t->nfirst) return kTRUE;
+  return (t->every > 0 && (n - t->nfirst) % t->every == 0);
+}
+
+void THcDiagnostics::Keep(Int_t type, const char* text)
+{
+  /// Put a message in the buffer, replacing the oldest one if it is full
+  if(type < 0 || (UInt_t) type >= fTypes.size()) return;
+  fTypes[type]->kept++;
+  if(fNKept >= fBuffer.size()) {
+    fNLost++;
+  } else {
+    fNKept++;
+  }
+  fBuffer[fNext].type = type;
+  fBuffer[fNext].text = text;
+  fNext = (fNext+1) % fBuffer.size();
+}
+
+void THcDiagnostics::Flush()
+{
+  /// Print the message counts and the buffered messages, then empty the buffer
+  Bool_t any = (fNKept > 0);
+  for(UInt_t i=0; i<fTypes.size() && !any; i++) {
+    any = (fTypes[i]->count > 0);
+  }
+  if(!any) return;
+
+  cout << "-------------------------------------------------------------------" << endl;
+  cout << "------------------------ Event loop warnings ----------------------" << endl;
+  cout << "-------------------------------------------------------------------" << endl;
+  for(UInt_t i=0; i<fTypes.size(); i++) {
+    const MessageType* t = fTypes[i];
+    if(t->count == 0) continue;
+    cout << setw(10) << t->count << "  " << t->description
+	 << " (" << t->key << ", " << t->kept << " kept)" << endl;
+  }
+  if(fNLost > 0) {
+    cout << "Oldest " << fNLost << " messages not shown" << endl;
+  }
+  UInt_t first = (fNext + fBuffer.size() - fNKept) % fBuffer.size();
+  for(UInt_t i=0; i<fNKept; i++) {
+    const Message& m = fBuffer[(first+i) % fBuffer.size()];
+    cout << m.text << endl;
+  }
+  cout << "-------------------------------------------------------------------" << endl;
+  fNext = 0;
+  fNKept = 0;
+  fNLost = 0;
+}
+
+void THcDiagnostics::Reset()
+{
+  /// Zero the counts and drop the buffered messages, for a new run.
+  /// The registered types are kept.
+  for(UInt_t i=0; i<fTypes.size(); i++) {
+    fTypes[i]->count = 0;
+    fTypes[i]->kept = 0;
+  }
+  fNext = 0;
+  fNKept = 0;
+  fNLost = 0;
+}
+
+ClassImp(THcDiagnostics)
@@ -0,0 +1,56 @@
+#ifndef ROOT_THcDiagnostics
+#define ROOT_THcDiagnostics
+
+//////////////////////////////////////////////////////////////////////////
+//
+// THcDiagnostics
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "TObject.h"
+#include "TString.h"
+
+#include <vector>
+
+class THcDiagnostics : public TObject {
+
+public:
+
+  THcDiagnostics(UInt_t nkeep=1000);
+  virtual ~THcDiagnostics();
+
+  Int_t  Register(const char* key, const char* description,
+		  UInt_t nfirst=10, UInt_t every=1000);
+  Bool_t Count(Int_t type);
+  void   Keep(Int_t type, const char* text);
+  void   Flush();
+  void   Reset();
+
+  Int_t  GetType(const char* key) const;
+  UInt_t GetCount(Int_t type) const;
+  UInt_t GetNTypes() const { return fTypes.size(); }
+
+protected:
+
+  struct MessageType {		// Counters and sampling of one kind of message
+    TString key;
+    TString description;
+    UInt_t nfirst;		// Keep the first nfirst messages
+    UInt_t every;		// then every every'th, 0 for none
+    Int_t count;		// Messages so far, also in gHcParms
+    UInt_t kept;		// Messages put in the buffer
+  };
+  struct Message {		// One kept message
+    Int_t type;
+    TString text;
+  };
+
+  std::vector<MessageType*> fTypes;
+  std::vector<Message> fBuffer;	// Ring buffer of kept messages
+  UInt_t fNext;			// Buffer position of the next message
+  UInt_t fNKept;		// Messages kept since the last flush
+  UInt_t fNLost;		// Messages overwritten since the last flush
+
+  ClassDef(THcDiagnostics,0);  // Rate-limited event loop warnings
+};
+#endif
@@ -20,7 +20,6 @@
 #include "THaTrack.h"
 #include "TClonesArray.h"
 #include "TMath.h"
-#include "TVectorD.h"
 #include "THcSpacePoint.h"
 #include "THaApparatus.h"
 
@@ -31,6 +30,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
 using namespace std;
 
@@ -140,6 +140,7 @@ Int_t THcDriftChamber::ReadDatabase( const TDatime& date )
     {"dc_wire_velocity", &fWireVelocity, kDouble},
     {"SmallAngleApprox", &fSmallAngleApprox, kInt,0,1},
     {"stub_max_xpdiff", &fStubMaxXPDiff, kDouble,0,1},
+    {"dc_max_hits_per_point", &fMaxHitsPerPoint, kInt,0,1},
     {"debugflagpr", &fhdebugflagpr, kInt},
     {"debugstubchisq", &fdebugstubchisq, kInt},
     {Form("dc_%d_zpos",fChamberNum), &fZPos, kDouble},
@@ -154,7 +155,17 @@ Int_t THcDriftChamber::ReadDatabase( const TDatime& date )
   if (test == HMS ) fRatio_xpfp_to_xfp=0.0011; // HMS 
   fRemove_Sppt_If_One_YPlane = 0; // Default
   fStubMaxXPDiff = 999.;	  // 
+  fMaxHitsPerPoint = MAX_HITS_PER_POINT;
   gHcParms->LoadParmValues((DBRequest*)&list,prefix);
+  // The per plane hit arrays of SpacePointMultiWire and the fit arrays
+  // hold MAX_HITS_PER_POINT hits, and a hard space point starts with up
+  // to 4 hits
+  if(fMaxHitsPerPoint < 4 || fMaxHitsPerPoint > MAX_HITS_PER_POINT) {
+    static const char* const here = "ReadDatabase";
+    Warning(Here(here), "%sdc_max_hits_per_point = %d out of range 4-%d, using %d",
+	    prefix, fMaxHitsPerPoint, MAX_HITS_PER_POINT, MAX_HITS_PER_POINT);
+    fMaxHitsPerPoint = MAX_HITS_PER_POINT;
+  }
   // Get parameters parent knows about
   fParent = GetParent();
   fMinHits = static_cast<THcDC*>(fParent)->GetMinHits(fChamberNum);
@@ -189,10 +200,10 @@ Int_t THcDriftChamber::ReadDatabase( const TDatime& date )
     fStubCoefs[ip] = fPlanes[ip]->GetStubCoef();
     allplanes |= 1<<ip;
   }
-  // Unordered map introduced in C++-11
-  // Can use unordered_map if using C++-11
-  // May not want to use map a all for performance, but using it now
-  // for code clarity
+  // Inverse matrices are stored flat, 9 elements per plane bit pattern,
+  // so LeftRight can index them directly.  Patterns with more than two
+  // planes missing are left at zero.
+  fAA3Inv.assign(9*(1<<fNPlanes), 0.0);
   for(Int_t ipm1=0;ipm1<fNPlanes+1;ipm1++) { // Loop over missing plane1
     for(Int_t ipm2=ipm1;ipm2<fNPlanes+1;ipm2++) {
       if(ipm1==ipm2 && ipm1<fNPlanes) continue;
@@ -212,8 +223,11 @@ Int_t THcDriftChamber::ReadDatabase( const TDatime& date )
       // Should check that it is invertable
       //      if (fhdebugflagpr) cout << bitpat << " Determinant: " << AA3->Determinant() << endl;
       AA3.Invert();
-      fAA3Inv[bitpat].ResizeTo(AA3);
-      fAA3Inv[bitpat] = AA3;
+      for(Int_t i=0;i<3;i++) {
+	for(Int_t j=0;j<3;j++) {
+	  fAA3Inv[9*bitpat+3*i+j] = AA3[i][j];
+	}
+      }
     }
   }
 
@@ -233,6 +247,7 @@ Int_t THcDriftChamber::DefineVariables( EMode mode )
   RVarDef vars[] = {
     { "maxhits",     "Maximum hits allowed",    "fMaxHits" },
     { "spacepoints", "Space points of DC",      "fNSpacePoints" },
+    { "sp_truncated", "Space points at the hits per point limit", "fNTruncatedSpacePoints" },
     { "nhit", "Number of DC hits",  "fNhits" },
     { "trawhit", "Number of True Raw hits", "fN_True_RawHits" },
     { "stub_x", "", "fSpacePoints.THcSpacePoint.GetStubX()" },
@@ -294,10 +309,12 @@ Int_t THcDriftChamber::FindSpacePoints( void )
 3. if not  EasySpacePoint calls FindHardSpacePoints
   1. loops though hits and determines pairs of hits in planes with angles grerater then 17.5 degs
       between them. These are test pairs and stores the x and y position of pair
-  1. Double loops through the test pairs to determine number of pair combinations.
+  1. Sorts the test pairs into a grid of cells of size sqrt(fSpacePointCriterion)
+     and compares each pair to the pairs in its own and neighbouring cells.
      1. Calculates d2 = (xi -xj)^2 + (yi-yj)^2 from the two pairs (i,j).
      2. If d2 <  fSpacePointCriterion then fills combos structure with pair info
-         and increments ncombos.
+         and increments ncombos.  Combos are in the same order as a double loop
+         over the pairs would give.
   c. Loop through ncombos
      1. First combo is set as spacepoint which is loaded with hit info from combos.
      2. Next combo 
@@ -316,14 +333,16 @@ Int_t THcDriftChamber::FindSpacePoints( void )
           that do not have nhits >  min_hits and ncombos> min_combos 
           ( exception for easyspacepoint)
   */
-  // fSpacePoints->Clear();
-  fSpacePoints->Delete();
+  // Space points are reused with ConstructedAt, keeping their hit
+  // lists, so no memory is allocated once enough space points exist.
+  fSpacePoints->Clear();
 
   Int_t plane_hitind=0;
   Int_t planep_hitind=0;
 
 
   fNSpacePoints=0;
+  fNTruncatedSpacePoints=0;
   fEasySpacePoint = 0;
   if(fNhits >= fMinHits && fNhits < fMaxHits) {
     for(Int_t ihit=0;ihit<fNhits;ihit++) {
@@ -421,7 +440,7 @@ Int_t THcDriftChamber::FindEasySpacePoint_HMS(Int_t yplane_hitind,Int_t yplanep_
     sp->SetXY(xt, yt);
     sp->SetCombos(0);
     for(Int_t ihit=0;ihit<fNhits;ihit++) {
-      sp->AddHit(fHits[ihit]);
+      AddSpacePointHit(sp, fHits[ihit]);
     }
   }
   return(easy_space_point);
@@ -472,7 +491,7 @@ Int_t THcDriftChamber::FindEasySpacePoint_SOS(Int_t xplane_hitind,Int_t xplanep_
     sp->SetXY(xt, yt);
     sp->SetCombos(0);
     for(Int_t ihit=0;ihit<fNhits;ihit++) {
-      sp->AddHit(fHits[ihit]);
+      AddSpacePointHit(sp, fHits[ihit]);
     }
   }
   return(easy_space_point);
@@ -482,68 +501,92 @@ Int_t THcDriftChamber::FindEasySpacePoint_SOS(Int_t xplane_hitind,Int_t xplanep_
 // Generic
 Int_t THcDriftChamber::FindHardSpacePoints()
 {
-  Int_t MAX_NUMBER_PAIRS=1000; // Where does this get set?
-  struct Pair {
-    THcDCHit* hit1;
-    THcDCHit* hit2;
-    Double_t x, y;
-  };
-  Pair pairs[MAX_NUMBER_PAIRS];
-  //
-  Int_t ntest_points=0;
+  // Pairs and combos are kept in members so the buffers are reused
+  // from event to event.  They grow as needed, so nothing is dropped.
+  fHardPairs.clear();
   for(Int_t ihit1=0;ihit1<fNhits-1;ihit1++) {
     THcDCHit* hit1=fHits[ihit1];
     THcDriftChamberPlane* plane1 = hit1->GetWirePlane();
     for(Int_t ihit2=ihit1+1;ihit2<fNhits;ihit2++) {
-      if(ntest_points < MAX_NUMBER_PAIRS) {
-	THcDCHit* hit2=fHits[ihit2];
-	THcDriftChamberPlane* plane2 = hit2->GetWirePlane();
-	Double_t determinate = plane1->GetXsp()*plane2->GetYsp()
-	  -plane1->GetYsp()*plane2->GetXsp();
-	if(TMath::Abs(determinate) > 0.3) { // 0.3 is sin(alpha1-alpha2)=sin(17.5)
-	  pairs[ntest_points].hit1 = hit1;
-	  pairs[ntest_points].hit2 = hit2;
-	  pairs[ntest_points].x = (hit1->GetPos()*plane2->GetYsp()
-				   - hit2->GetPos()*plane1->GetYsp())
-	    /determinate;
-	  pairs[ntest_points].y = (hit2->GetPos()*plane1->GetXsp()
-				   - hit1->GetPos()*plane2->GetXsp())
-	    /determinate;
-	  ntest_points++;
-	}
+      THcDCHit* hit2=fHits[ihit2];
+      THcDriftChamberPlane* plane2 = hit2->GetWirePlane();
+      Double_t determinate = plane1->GetXsp()*plane2->GetYsp()
+	-plane1->GetYsp()*plane2->GetXsp();
+      if(TMath::Abs(determinate) > 0.3) { // 0.3 is sin(alpha1-alpha2)=sin(17.5)
+	HardPair pair;
+	pair.hit1 = hit1;
+	pair.hit2 = hit2;
+	pair.x = (hit1->GetPos()*plane2->GetYsp()
+		  - hit2->GetPos()*plane1->GetYsp())
+	  /determinate;
+	pair.y = (hit2->GetPos()*plane1->GetXsp()
+		  - hit1->GetPos()*plane2->GetXsp())
+	  /determinate;
+	fHardPairs.push_back(pair);
       }
     }
   }
-  Int_t ncombos=0;
-  struct Combo {
-    Pair* pair1;
-    Pair* pair2;
-  };
-  Combo combos[10*MAX_NUMBER_PAIRS];
+  Int_t ntest_points = fHardPairs.size();
+
+  // Pairs closer than the space point criterion are at most one cell
+  // apart, so only the 3x3 cells around each pair need to be searched.
+  Double_t cellsize = (fSpacePointCriterion > 0) ? TMath::Sqrt(fSpacePointCriterion) : 1.0;
+  fHardCells.resize(ntest_points);
+  for(Int_t ipair=0;ipair<ntest_points;ipair++) {
+    fHardCells[ipair].ix = (Int_t) TMath::Floor(fHardPairs[ipair].x/cellsize);
+    fHardCells[ipair].iy = (Int_t) TMath::Floor(fHardPairs[ipair].y/cellsize);
+    fHardCells[ipair].ipair = ipair;
+  }
+  std::sort(fHardCells.begin(), fHardCells.end());
+
+  fHardCombos.clear();
+  std::vector<Int_t>& neighbours = fHardNeighbours;
   for(Int_t ipair1=0;ipair1<ntest_points-1;ipair1++) {
-    for(Int_t ipair2=ipair1+1;ipair2<ntest_points;ipair2++) {
-      if(ncombos < 10*MAX_NUMBER_PAIRS) {
-	Double_t dist2 = pow(pairs[ipair1].x - pairs[ipair2].x,2)
-	  + pow(pairs[ipair1].y - pairs[ipair2].y,2);
-	if(dist2 <= fSpacePointCriterion) {
-	  combos[ncombos].pair1 = &pairs[ipair1];
-	  combos[ncombos].pair2 = &pairs[ipair2];
-	  ncombos++;
+    const HardPair& pair1 = fHardPairs[ipair1];
+    Int_t ix = (Int_t) TMath::Floor(pair1.x/cellsize);
+    Int_t iy = (Int_t) TMath::Floor(pair1.y/cellsize);
+    neighbours.clear();
+    for(Int_t jx=ix-1;jx<=ix+1;jx++) {
+      for(Int_t jy=iy-1;jy<=iy+1;jy++) {
+	HardCell key;
+	key.ix = jx;
+	key.iy = jy;
+	key.ipair = ipair1+1;	// Only pairs after ipair1
+	std::vector<HardCell>::const_iterator it =
+	  std::lower_bound(fHardCells.begin(), fHardCells.end(), key);
+	while(it != fHardCells.end() && it->ix == jx && it->iy == jy) {
+	  const HardPair& pair2 = fHardPairs[it->ipair];
+	  Double_t dist2 = pow(pair1.x - pair2.x,2)
+	    + pow(pair1.y - pair2.y,2);
+	  if(dist2 <= fSpacePointCriterion) {
+	    neighbours.push_back(it->ipair);
+	  }
+	  ++it;
 	}
       }
     }
+    std::sort(neighbours.begin(), neighbours.end());
+    for(UInt_t i=0;i<neighbours.size();i++) {
+      HardCombo combo;
+      combo.ipair1 = ipair1;
+      combo.ipair2 = neighbours[i];
+      fHardCombos.push_back(combo);
+    }
   }
+  Int_t ncombos = fHardCombos.size();
   // Loop over all valid combinations and build space points
   //if (fhdebugflagpr) cout << "looking for hard Space Point combos = " << ncombos << endl;
   for(Int_t icombo=0;icombo<ncombos;icombo++) {
+    const HardPair& pair1 = fHardPairs[fHardCombos[icombo].ipair1];
+    const HardPair& pair2 = fHardPairs[fHardCombos[icombo].ipair2];
     THcDCHit* hits[4];
-    hits[0]=combos[icombo].pair1->hit1;
-    hits[1]=combos[icombo].pair1->hit2;
-    hits[2]=combos[icombo].pair2->hit1;
-    hits[3]=combos[icombo].pair2->hit2;
+    hits[0]=pair1.hit1;
+    hits[1]=pair1.hit2;
+    hits[2]=pair2.hit1;
+    hits[3]=pair2.hit2;
     // Get Average Space point xt, yt
-    Double_t xt = (combos[icombo].pair1->x + combos[icombo].pair2->x)/2.0;
-    Double_t yt = (combos[icombo].pair1->y + combos[icombo].pair2->y)/2.0;
+    Double_t xt = (pair1.x + pair2.x)/2.0;
+    Double_t yt = (pair1.y + pair2.y)/2.0;
     // Loop over space points
     
     if(fNSpacePoints > 0) {
@@ -584,7 +627,7 @@ Int_t THcDriftChamber::FindHardSpacePoints()
 	    // Add the unique combo hits to the space point
 	    for(Int_t icm=0;icm<4;icm++) {
 	      if(iflag[icm]==0) {
-		sp->AddHit(hits[icm]);
+		AddSpacePointHit(sp, hits[icm]);
 	      }
 	    }
 	    sp->IncCombos();
@@ -634,6 +677,23 @@ Int_t THcDriftChamber::FindHardSpacePoints()
   return(fNSpacePoints);
 }
 
+//_____________________________________________________________________________
+Bool_t THcDriftChamber::AddSpacePointHit(THcSpacePoint* sp, THcDCHit* hit)
+{
+  // Add a hit to a space point unless it already has fMaxHitsPerPoint
+  // hits.  Dropped hits flag the space point as truncated, and each
+  // truncated space point is counted once in fNTruncatedSpacePoints.
+  if(sp->GetNHits() >= fMaxHitsPerPoint) {
+    if(!sp->IsTruncated()) {
+      sp->SetTruncated();
+      fNTruncatedSpacePoints++;
+    }
+    return kFALSE;
+  }
+  sp->AddHit(hit);
+  return kTRUE;
+}
+
 //_____________________________________________________________________________
 // HMS Specific?
 Int_t THcDriftChamber::DestroyPoorSpacePoints()
@@ -693,6 +753,7 @@ Int_t THcDriftChamber::DestroyPoorSpacePoints()
 	THcDCHit* hit = spo->GetHit(ihit);
 	spi->AddHit(hit);
       }
+      if(spo->IsTruncated()) spi->SetTruncated();
     }
   }
   return nremoved;
@@ -964,114 +1025,107 @@ void THcDriftChamber::CorrectHitTimes()
     Double_t y = sp->GetY();
     for(Int_t ihit=0;ihit<sp->GetNHits();ihit++) {
       THcDCHit* hit = sp->GetHit(ihit);
-      THcDriftChamberPlane* plane=hit->GetWirePlane();
-      
-      // How do we know this correction only gets applied once?  Is
-      // it determined that a given hit can only belong to one space point?
-      Double_t time_corr = plane->GetReadoutX() ?
-	y*plane->GetReadoutCorr()/fWireVelocity :
-	x*plane->GetReadoutCorr()/fWireVelocity;
-
-      // This applies the wire velocity correction for new SHMS chambers --hszumila, SEP17
-      if (!fHMSStyleChambers){
-	Int_t pln = hit->GetPlaneNum();
-	Int_t readoutSide = hit->GetReadoutSide();
-
-	Double_t posn = hit->GetPos();
-	//The following values are determined from param file as permutations on planes 5 and 10
-	Int_t readhoriz = plane->GetReadoutLR();
-	Int_t readvert = plane->GetReadoutTB();
-
-	//+x is up and +y is beam right!
-	double alpha = static_cast<THcDC*>(fParent)->GetAlphaAngle(pln);
-	double xc = posn*TMath::Sin(alpha);
-	double yc = posn*TMath::Cos(alpha);
-
-	Double_t wireDistance = plane->GetReadoutX() ?
-	  (abs(y-yc))*abs(plane->GetReadoutCorr()) :
-	  (abs(x-xc))*abs(plane->GetReadoutCorr());
-
-	//Readout side is based off wiring diagrams
-	switch (readoutSide){
-	case 1: //readout from top of chamber
-	  if (x>xc){wireDistance = -readvert*wireDistance;}
-	  else{wireDistance = readvert*wireDistance;}
-	  
-	  break;
-	case 2://readout from right of chamber
-	  if (y>yc){wireDistance = -readhoriz*wireDistance;}
-	  else{wireDistance = readhoriz*wireDistance;}
-  
-	  break;
-	case 3: //readout from bottom of chamber
-	  if (xc>x){wireDistance= -readvert*wireDistance;}
-	  else{wireDistance = readvert*wireDistance;}
-
-	  break;
-	case 4: //readout from left of chamber
-	  if(yc>y){wireDistance = -readhoriz*wireDistance;}
-	  else{wireDistance = readhoriz*wireDistance;}
-
-	  break;
-	default:
-	  wireDistance = 0.0;
-	}
-
-	Double_t timeCorrection = wireDistance/fWireVelocity;
-
-	if(fFixPropagationCorrection==0) { // ENGINE behavior
-	  Double_t time=hit->GetTime();
-	  hit->SetTime(time - timeCorrection);
-	  hit->ConvertTimeToDist();
-	} else {
-	  Double_t time=hit->GetTime();
-	  Double_t dist=hit->GetDist();
-
-	  hit->SetTime(time - timeCorrection);
-	  //double usingOldTime = time-time_corr;
-	  //hit->SetTime(time- time_corr);
-
-	  hit->ConvertTimeToDist();
-	  sp->SetHitDist(ihit, hit->GetDist());
-
-	  hit->SetTime(time);	// Restore time
-	  hit->SetDist(dist);	// Restore distance
-	}
 
+      // Fortran ENGINE does not do this check, so hits can get "corrected"
+      // multiple times if they belong to multiple space points.
+      // To reproduce the precise ENGINE behavior, remove this if condition.
+      if(fFixPropagationCorrection==0) { // ENGINE behavior
+	hit->SetTime(CorrectedHitTime(hit, x, y));
+	hit->ConvertTimeToDist();
+	//      hit->SetCorrectedStatus(1);
       } else {
-	/////////////////////////////////////////////////////////////
-	
-	//     if (fhdebugflagpr) cout << "Correcting hit " << hit << " " << plane->GetPlaneNum() << " " << isp << "/" << ihit << "  " << x << "," << y << endl;
-	// Fortran ENGINE does not do this check, so hits can get "corrected"
-	// multiple times if they belong to multiple space points.
-	// To reproduce the precise ENGINE behavior, remove this if condition.
-	if(fFixPropagationCorrection==0) { // ENGINE behavior
-	  hit->SetTime(hit->GetTime() - plane->GetCentralTime()
-		       + plane->GetDriftTimeSign()*time_corr);
-	  hit->ConvertTimeToDist();
-	  //      hit->SetCorrectedStatus(1);
-	} else {
-	  // New behavior: Save corrected distance with the hit in the space point
-	  // so that the same hit can have a different correction depending on
-	  // which space point it is in.
-	  //
-	  // This is a hack now because the converttimetodist method is connected to the hit
-	  // so I compute the corrected time and distance, and then restore the original
-	  // time and distance.  Can probably add a method to hit that does a conversion on a time
-	  // but does not modify the hit data.
-	  Double_t time=hit->GetTime();
-	  Double_t dist=hit->GetDist();
-	  hit->SetTime(time - plane->GetCentralTime()
-		       + plane->GetDriftTimeSign()*time_corr);
-	  hit->ConvertTimeToDist();
-	  sp->SetHitDist(ihit, hit->GetDist());
-	  hit->SetTime(time);	// Restore time
-	  hit->SetDist(dist);	// Restore distance
-	}
+	// New behavior: Save corrected distance with the hit in the space point
+	// so that the same hit can have a different correction depending on
+	// which space point it is in.
+	sp->SetHitDist(ihit, CorrectedHitDist(hit, x, y));
       }
     }
   }
 }
+
+Double_t THcDriftChamber::CorrectedHitTime(THcDCHit* hit, Double_t x, Double_t y)
+{
+  /**
+   Drift time of a hit corrected for the propagation along the wire,
+   for a track passing the chamber at (x,y).  The hit is not changed.
+  */
+  THcDriftChamberPlane* plane=hit->GetWirePlane();
+
+  // This applies the wire velocity correction for new SHMS chambers --hszumila, SEP17
+  if (!fHMSStyleChambers){
+    Int_t pln = hit->GetPlaneNum();
+    Int_t readoutSide = hit->GetReadoutSide();
+
+    Double_t posn = hit->GetPos();
+    //The following values are determined from param file as permutations on planes 5 and 10
+    Int_t readhoriz = plane->GetReadoutLR();
+    Int_t readvert = plane->GetReadoutTB();
+
+    //+x is up and +y is beam right!
+    double alpha = static_cast<THcDC*>(fParent)->GetAlphaAngle(pln);
+    double xc = posn*TMath::Sin(alpha);
+    double yc = posn*TMath::Cos(alpha);
+
+    Double_t wireDistance = plane->GetReadoutX() ?
+      (abs(y-yc))*abs(plane->GetReadoutCorr()) :
+      (abs(x-xc))*abs(plane->GetReadoutCorr());
+
+    //Readout side is based off wiring diagrams
+    switch (readoutSide){
+    case 1: //readout from top of chamber
+      if (x>xc){wireDistance = -readvert*wireDistance;}
+      else{wireDistance = readvert*wireDistance;}
+
+      break;
+    case 2://readout from right of chamber
+      if (y>yc){wireDistance = -readhoriz*wireDistance;}
+      else{wireDistance = readhoriz*wireDistance;}
+
+      break;
+    case 3: //readout from bottom of chamber
+      if (xc>x){wireDistance= -readvert*wireDistance;}
+      else{wireDistance = readvert*wireDistance;}
+
+      break;
+    case 4: //readout from left of chamber
+      if(yc>y){wireDistance = -readhoriz*wireDistance;}
+      else{wireDistance = readhoriz*wireDistance;}
+
+      break;
+    default:
+      wireDistance = 0.0;
+    }
+
+    Double_t timeCorrection = wireDistance/fWireVelocity;
+    return hit->GetTime() - timeCorrection;
+  }
+
+  Double_t time_corr = plane->GetReadoutX() ?
+    y*plane->GetReadoutCorr()/fWireVelocity :
+    x*plane->GetReadoutCorr()/fWireVelocity;
+  return hit->GetTime() - plane->GetCentralTime()
+    + plane->GetDriftTimeSign()*time_corr;
+}
+
+Double_t THcDriftChamber::CorrectedHitDist(THcDCHit* hit, Double_t x, Double_t y)
+{
+  /**
+   Drift distance for the corrected time from CorrectedHitTime.  The hit
+   keeps its own time and distance.
+  */
+  // This is a hack now because the converttimetodist method is connected to the hit
+  // so I compute the corrected time and distance, and then restore the original
+  // time and distance.  Can probably add a method to hit that does a conversion on a time
+  // but does not modify the hit data.
+  Double_t time=hit->GetTime();
+  Double_t dist=hit->GetDist();
+  hit->SetTime(CorrectedHitTime(hit, x, y));
+  hit->ConvertTimeToDist();
+  Double_t corrdist = hit->GetDist();
+  hit->SetTime(time);	// Restore time
+  hit->SetDist(dist);	// Restore distance
+  return corrdist;
+}
 UInt_t THcDriftChamber::Count1Bits(UInt_t x)
 // From http://graphics.stanford.edu/~seander/bithacks.html
 {
@@ -1126,6 +1180,15 @@ void THcDriftChamber::LeftRight()
       if(pindex == YPlaneInd) hasy1 = ihit;
       if(pindex == YPlanePInd) hasy2 = ihit;
     }
+    // Space points are built with at most fMaxHitsPerPoint hits, which
+    // keeps 1<<nhits in range.  Skip any that got more some other way.
+    if(nhits > fMaxHitsPerPoint) {
+      if(!sp->IsTruncated()) {
+	sp->SetTruncated();
+	fNTruncatedSpacePoints++;
+      }
+      continue;
+    }
     nplusminus = 1<<nhits;
     if(fHMSStyleChambers) {
       Int_t smallAngOK = (hasy1>=0) && (hasy2>=0);
@@ -1177,26 +1240,64 @@ void THcDriftChamber::LeftRight()
     }
     Int_t nplaneshit = Count1Bits(bitpat);
     //if (fhdebugflagpr) cout << " num of pm = " << nplusminus << " num of hits =" << nhits << endl;
-    // Use bit value of integer word to set + or -
-    // Loop over all combinations of left right.
+    // Hits with unknown left/right, in the bit order of the loop counter.
+    // Start with all of them on the minus side.
+    Int_t freehit[nhits];
+    Int_t nfree = 0;
+    for(Int_t ihit=0;ihit<nhits;ihit++) {
+      if(plusminusknown[ihit]!=0) {
+	plusminus[ihit] = plusminusknown[ihit];
+      } else {
+	plusminus[ihit] = -1;
+	freehit[nfree++] = ihit;
+      }
+    }
+    // Wire position and drift distance in units of sigma.  The fit only
+    // needs TT = sum(w*coef) and sum(w*w) with w = wpos + plusminus*wdist,
+    // which are updated when a hit is flipped, and the normal matrix of
+    // the hits, which does not depend on left/right.
+    Double_t wpos[nhits];
+    Double_t wdist[nhits];
+    Double_t TT[3] = {0.0, 0.0, 0.0};
+    Double_t AA[9] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    Double_t sumw2 = 0.0;
+    for(Int_t ihit=0;ihit<nhits;ihit++) {
+      Int_t pindex = plane_list[ihit];
+      wpos[ihit] = (sp->GetHit(ihit)->GetPos() - fPsi0[pindex])/fSigma[pindex];
+      wdist[ihit] = sp->GetHitDist(ihit)/fSigma[pindex];
+      Double_t w = wpos[ihit] + plusminus[ihit]*wdist[ihit];
+      sumw2 += w*w;
+      for(Int_t i=0;i<3;i++) {
+	TT[i] += w*fStubCoefs[pindex][i];
+	for(Int_t j=0;j<3;j++) {
+	  AA[3*i+j] += fStubCoefs[pindex][i]*fStubCoefs[pindex][j];
+	}
+      }
+    }
+    const Double_t* aa3inv = &fAA3Inv[9*bitpat];
+    // Loop over all combinations of left right in Gray code order, so
+    // each combination differs from the previous one by a single hit.
     for(Int_t pmloop=0;pmloop<nplusminus;pmloop++) {
-      Int_t iswhit = 1;
-      for(Int_t ihit=0;ihit<nhits;ihit++) {
-	if(plusminusknown[ihit]!=0) {
-	  plusminus[ihit] = plusminusknown[ihit];
-	} else {
-	  // Max hits per point has to be less than 32.
-	  if(pmloop & iswhit) {
-	    plusminus[ihit] = 1;
-	  } else {
-	    plusminus[ihit] = -1;
-	  }
-	  iswhit <<= 1;
+      if(pmloop > 0) {
+	// Bit that changes is the lowest set bit of the loop counter
+	Int_t ifree = 0;
+	while(((pmloop>>ifree)&1) == 0) ifree++;
+	Int_t ihit = freehit[ifree];
+	Double_t wold = wpos[ihit] + plusminus[ihit]*wdist[ihit];
+	plusminus[ihit] = -plusminus[ihit];
+	Double_t wnew = wpos[ihit] + plusminus[ihit]*wdist[ihit];
+	sumw2 += wnew*wnew - wold*wold;
+	for(Int_t i=0;i<3;i++) {
+	  TT[i] += (wnew - wold)*fStubCoefs[plane_list[ihit]][i];
 	}
       }
       if (nplaneshit >= fNPlanes-1) {
-	Double_t chi2;
-	chi2 = FindStub(nhits, sp,plane_list, bitpat, plusminus, stub);
+	Double_t chi2 = FindStub(TT, sumw2, AA, aa3inv, stub);
+	// The expanded chi2 is a small difference of large sums.  Refit
+	// any combination that may beat the best one from its residuals.
+	if(chi2 < minchi2 + 1.0e-8*sumw2) {
+	  chi2 = FitStub(nhits, plane_list, wpos, wdist, plusminus, aa3inv, stub);
+	}
 	if (fdebugstubchisq) cout << " pmloop = " << pmloop << " chi2 = " << chi2 << endl;
 	if(chi2 < minchi2) {
 	  if (fStubMaxXPDiff<100. ) {
@@ -1238,7 +1339,7 @@ void THcDriftChamber::LeftRight()
 	}
 	///////////////
       } else if (nplaneshit >= fNPlanes-2 && fHMSStyleChambers) { // Two planes missing
-	Double_t chi2 = FindStub(nhits, sp,plane_list, bitpat, plusminus, stub);
+	Double_t chi2 = FindStub(TT, sumw2, AA, aa3inv, stub);
 	//if(debugging)
 	//if (fhdebugflagpr) cout << "pmloop=" << pmloop << " Chi2=" << chi2 << endl;
 	// Isn't this a bad idea, doing == with reals
@@ -1249,7 +1350,7 @@ void THcDriftChamber::LeftRight()
 	  /(1+stub[2]*fTanBeta[plane_list[0]]);
 	if(TMath::Abs(xp_fit) <= minxp) {
 	  minxp = TMath::Abs(xp_fit);
-	  minchi2 = chi2;
+	  minchi2 = FitStub(nhits, plane_list, wpos, wdist, plusminus, aa3inv, stub);
 	  for(Int_t ihit=0;ihit<nhits;ihit++) {
 	    plusminusbest[ihit] = plusminus[ihit];
 	  }
@@ -1305,47 +1406,66 @@ void THcDriftChamber::LeftRight()
   // Option to print stubs
 }
 //_____________________________________________________________________________
-Double_t THcDriftChamber::FindStub(Int_t nhits, THcSpacePoint *sp,
-				       Int_t* plane_list, UInt_t bitpat,
-				       Int_t* plusminus, Double_t* stub)
+Double_t THcDriftChamber::FindStub(const Double_t* TT, Double_t sumw2,
+				   const Double_t* AA, const Double_t* aa3inv,
+				   Double_t* stub)
 {
   // For a given combination of L/R, fit a stub to the space point
   // This method does a linear least squares fit of a line to the
   // hits in an individual chamber.  It assumes that the y slope is 0
   // The wire coordinate is calculated by
   //          wire center + plusminus*(drift distance).
-  // Method is called in a loop over all combinations of plusminus
-  Double_t zeros[] = {0.0,0.0,0.0};
-  TVectorD TT; TT.Use(3, zeros); // X, X', Y
-  Double_t dpos[nhits];
-  for(Int_t ihit=0;ihit<nhits; ihit++) {
-    dpos[ihit] = sp->GetHit(ihit)->GetPos()
-      + plusminus[ihit]*sp->GetHitDist(ihit)
-      - fPsi0[plane_list[ihit]];
-    for(Int_t index=0;index<3;index++) {
-      TT[index]+= dpos[ihit]*fStubCoefs[plane_list[ihit]][index]
-	/fSigma[plane_list[ihit]];
-    }
+  // Method is called in a loop over all combinations of plusminus.
+  // TT is sum(w*coef), sumw2 is sum(w*w) and AA is sum(coef*coef) over
+  // the hits, where w is the wire coordinate over sigma.  aa3inv is the
+  // 3x3 inverse for the pattern of planes hit.
+  // Remember one power of sigma is in fStubCoefs
+  for(Int_t i=0;i<3;i++) {
+    stub[i] = aa3inv[3*i]*TT[0] + aa3inv[3*i+1]*TT[1] + aa3inv[3*i+2]*TT[2];
   }
-  //  fAA3Inv[bitpat].Print();
-  //  if (fhdebugflagpr) cout << TT[0] << " " << TT[1] << " " << TT[2] << endl;
-  //  TT.Print();
+  stub[3] = 0.0;
 
-  TT *= fAA3Inv[bitpat];
-  // if (fhdebugflagpr) cout << TT[0] << " " << TT[1] << " " << TT[2] << endl;
+  // chi2 = sum((w - coef.stub)**2), expanded in the sums.  Only good
+  // enough to screen combinations, FitStub gives the exact value.
+  Double_t chi2 = sumw2;
+  for(Int_t i=0;i<3;i++) {
+    chi2 -= 2*stub[i]*TT[i];
+    for(Int_t j=0;j<3;j++) {
+      chi2 += stub[i]*AA[3*i+j]*stub[j];
+    }
+  }
+  if(chi2 < 0.0) chi2 = 0.0;	// Rounding
+  return(chi2);
+}
 
-  // Calculate Chi2.  Remember one power of sigma is in fStubCoefs
-  stub[0] = TT[0];
-  stub[1] = TT[1];
-  stub[2] = TT[2];
+//_____________________________________________________________________________
+Double_t THcDriftChamber::FitStub(Int_t nhits, const Int_t* plane_list,
+				  const Double_t* wpos, const Double_t* wdist,
+				  const Int_t* plusminus, const Double_t* aa3inv,
+				  Double_t* stub)
+{
+  // Fit a stub to one L/R combination from scratch and return the chi2
+  // summed from the residuals of the hits.  Slower than FindStub, but
+  // free of the cancellation in the expanded sums.  wpos and wdist are
+  // the wire position and drift distance over sigma.
+  Double_t TT[3] = {0.0, 0.0, 0.0};
+  for(Int_t ihit=0;ihit<nhits;ihit++) {
+    Double_t w = wpos[ihit] + plusminus[ihit]*wdist[ihit];
+    for(Int_t i=0;i<3;i++) {
+      TT[i] += w*fStubCoefs[plane_list[ihit]][i];
+    }
+  }
+  for(Int_t i=0;i<3;i++) {
+    stub[i] = aa3inv[3*i]*TT[0] + aa3inv[3*i+1]*TT[1] + aa3inv[3*i+2]*TT[2];
+  }
   stub[3] = 0.0;
-  Double_t chi2=0.0;
-  for(Int_t ihit=0;ihit<nhits; ihit++) {
-    chi2 += pow( dpos[ihit]/fSigma[plane_list[ihit]]
-		 - fStubCoefs[plane_list[ihit]][0]*stub[0]
-		 - fStubCoefs[plane_list[ihit]][1]*stub[1]
-		 - fStubCoefs[plane_list[ihit]][2]*stub[2]
-		 , 2);
+
+  Double_t chi2 = 0.0;
+  for(Int_t ihit=0;ihit<nhits;ihit++) {
+    const Double_t* coef = fStubCoefs[plane_list[ihit]];
+    Double_t resid = wpos[ihit] + plusminus[ihit]*wdist[ihit]
+      - (coef[0]*stub[0] + coef[1]*stub[1] + coef[2]*stub[2]);
+    chi2 += resid*resid;
   }
   return(chi2);
 }
@@ -1392,6 +1512,8 @@ void THcDriftChamber::Clear( const Option_t* )
 
   //  fTrackProj->Clear();
   fNhits = 0;
+  fNSpacePoints = 0;
+  fNTruncatedSpacePoints = 0;
 
 }
 
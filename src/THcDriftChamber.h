@@ -23,6 +23,7 @@
 //class THaScCalib;
 class TClonesArray;
 class THcSpacePoint;
+class THcDCHit;
 
 class THcDriftChamber : public THaSubDetector {
 
@@ -40,6 +41,8 @@ public:
   virtual Int_t      FindSpacePoints( void ) ;
   virtual void       PrintDecode( void ) ;
   virtual void       CorrectHitTimes( void ) ;
+  Double_t           CorrectedHitTime(THcDCHit* hit, Double_t x, Double_t y);
+  Double_t           CorrectedHitDist(THcDCHit* hit, Double_t x, Double_t y);
   virtual void       LeftRight(void);
 
 
@@ -85,6 +88,7 @@ protected:
   Int_t fMinHits; 		// Minimum hits required to do something
   Int_t fMaxHits; 		// Maximum required to do something
   Int_t fMinCombos;             // Minimum # pairs in a space point
+  Int_t fMaxHitsPerPoint;	// Maximum hits in a space point, L/R tries 2**n
   Int_t fRemove_Sppt_If_One_YPlane;
   Double_t fWireVelocity;
   Int_t fSmallAngleApprox;
@@ -120,22 +124,51 @@ protected:
   Int_t      FindEasySpacePoint_HMS(Int_t yplane_hitind, Int_t yplanep_hitind);
   Int_t      FindEasySpacePoint_SOS(Int_t xplane_hitind, Int_t xplanep_hitind);
   Int_t      FindHardSpacePoints(void);
+  Bool_t     AddSpacePointHit(THcSpacePoint* sp, THcDCHit* hit);
   Int_t      DestroyPoorSpacePoints(void);
   Int_t      SpacePointMultiWire(void);
   void       ChooseSingleHit(void);
   void       SelectSpacePoints(void);
   UInt_t     Count1Bits(UInt_t x);
-  Double_t   FindStub(Int_t nhits, THcSpacePoint *sp,
-		      Int_t* plane_list, UInt_t bitpat,
-		      Int_t* plusminus, Double_t* stub);
+  Double_t   FindStub(const Double_t* TT, Double_t sumw2,
+		      const Double_t* AA, const Double_t* aa3inv,
+		      Double_t* stub);
+  Double_t   FitStub(Int_t nhits, const Int_t* plane_list,
+		     const Double_t* wpos, const Double_t* wdist,
+		     const Int_t* plusminus, const Double_t* aa3inv,
+		     Double_t* stub);
 
   std::vector<THcDCHit*> fHits;	/* All hits for this chamber */
   TClonesArray *fSpacePoints;
   Int_t fNSpacePoints;
+  Int_t fNTruncatedSpacePoints;	// Space points that reached fMaxHitsPerPoint
   Int_t fEasySpacePoint;	/* This event is an easy space point */
 
+  struct HardPair {		// Intersection of two hits, FindHardSpacePoints
+    THcDCHit* hit1;
+    THcDCHit* hit2;
+    Double_t x, y;
+  };
+  struct HardCell {		// Grid cell of a pair
+    Int_t ix, iy;
+    Int_t ipair;
+    bool operator<(const HardCell& rhs) const {
+      if(ix != rhs.ix) return ix < rhs.ix;
+      if(iy != rhs.iy) return iy < rhs.iy;
+      return ipair < rhs.ipair;
+    }
+  };
+  struct HardCombo {		// Two pairs close to each other
+    Int_t ipair1;
+    Int_t ipair2;
+  };
+  std::vector<HardPair> fHardPairs;
+  std::vector<HardCell> fHardCells;
+  std::vector<HardCombo> fHardCombos;
+  std::vector<Int_t> fHardNeighbours;	// Pairs near one pair
+
   Double_t* stubcoef[4];
-  std::map<int,TMatrixD> fAA3Inv;
+  std::vector<Double_t> fAA3Inv;	// 3x3 inverses, 9 per plane bit pattern
 
   THaDetectorBase* fParent;
 
@@ -36,8 +36,11 @@ THcDriftChamberPlane::THcDriftChamberPlane( const char* name,
 : THaSubDetector(name,description,parent), fTTDConv(0)
 {
   // Normal constructor with name and description
+  // Each TDC hit has one THcDCHit.  fHits owns the first in-window hit
+  // of each wire and fOtherHits the rest.  fRawHits points to all.
   fHits = new TClonesArray("THcDCHit",100);
-  fRawHits = new TClonesArray("THcDCHit",100);
+  fOtherHits = new TClonesArray("THcDCHit",100);
+  fRawHits = new TObjArray(100);
   fWires = new TClonesArray("THcDCWire", 100);
 
   fPlaneNum = planenum;
@@ -49,6 +52,7 @@ THcDriftChamberPlane::THcDriftChamberPlane() :
 {
   // Constructor
   fHits = NULL;
+  fOtherHits = NULL;
   fRawHits = NULL;
   fWires = NULL;
   fTTDConv = NULL;
@@ -61,6 +65,7 @@ THcDriftChamberPlane::~THcDriftChamberPlane()
   delete [] fSigmaWire;
   delete fWires;
   delete fHits;
+  delete fOtherHits;
   delete fRawHits;
   delete fTTDConv;
 
@@ -262,6 +267,23 @@ Int_t THcDriftChamberPlane::ReadDatabase( const TDatime& date )
     Int_t readoutside = GetReadoutSide(i+1);
     new((*fWires)[i]) THcDCWire( i+1, pos , fTzeroWire[i], fSigmaWire[i], readoutside, fTTDConv);    //added fTzeroWire/fSigmaWire to be read in as fTOffset --Carlos
   }
+
+  // Wires whose hits are dropped in ProcessHits
+  fWireMask.assign((nWires+31)/32, 0);
+  if(fParent->GetMaskDeadWires()) {
+    for(Int_t i=0;i<fParent->GetNDeadWires();i++) {
+      Int_t wire = fParent->GetDeadWireNum(i);
+      if(fParent->GetDeadWirePlane(i) == fPlaneNum && wire >= 1 && wire <= nWires) {
+	MaskWire(wire);
+      }
+    }
+  }
+  fHotWireOccupancy = fParent->GetHotWireOccupancy();
+  fHotWireNEvents = fParent->GetHotWireNEvents();
+  fNOccupancyEvents = 0;
+  fWireHitCount.assign(nWires, 0);
+  fNMaskedHits = 0;
+  fNBadWireHits = 0;
   
   THaApparatus* app = GetApparatus();
   const char* nm = "hod";
@@ -299,6 +321,7 @@ Int_t THcDriftChamberPlane::DefineVariables( EMode mode )
     {"dist","Drift distancess",
      "fHits.THcDCHit.GetDist()"},
     {"nhit", "Number of hits", "GetNHits()"},
+    {"nmasked", "Number of TDC hits on masked wires", "fNMaskedHits"},
     { 0 }
   };
 
@@ -311,6 +334,7 @@ void THcDriftChamberPlane::Clear( Option_t* )
   //cout << " Calling THcDriftChamberPlane::Clear " << GetName() << endl;
   // Clears the hit lists
   fHits->Clear();
+  fOtherHits->Clear();
   fRawHits->Clear();
 }
 
@@ -351,19 +375,40 @@ Int_t THcDriftChamberPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
   */
 
   fHits->Clear();
+  fOtherHits->Clear();
   fRawHits->Clear();
 
   Int_t nrawhits = rawhits->GetLast()+1;
   fNRawhits=0;
+  fNMaskedHits=0;
   Int_t ihit = nexthit;
   Int_t nextHit = 0;
-  Int_t nextRawHit = 0;
+  Int_t nextOtherHit = 0;
   while(ihit < nrawhits) {
     THcRawDCHit* hit = (THcRawDCHit *) rawhits->At(ihit);
     if(hit->fPlane > fPlaneNum) {
       break;
     }
     Int_t wireNum = hit->fCounter;
+    // A wire number outside the plane would index past the wire arrays
+    if(wireNum < 1 || wireNum > fNWires) {
+      if(fNBadWireHits++ < 10) {
+	static const char* const here = "ProcessHits()";
+	Warning(Here(here), "Hit on wire %d, plane has %d wires.  Skipped.%s",
+		wireNum, fNWires,
+		fNBadWireHits == 10 ? "  No further warnings." : "");
+      }
+      ihit++;
+      continue;
+    }
+    // Dead and hot wires are dropped before any THcDCHit is made
+    if(IsWireMasked(wireNum)) {
+      fNRawhits += hit->GetRawTdcHit().GetNHits();
+      fNMaskedHits += hit->GetRawTdcHit().GetNHits();
+      ihit++;
+      continue;
+    }
+    if(fHotWireOccupancy > 0) fWireHitCount[wireNum-1]++;
     THcDCWire* wire = GetWire(wireNum);
     Bool_t First_Hit_In_Window = kTRUE;
     for(UInt_t mhit=0; mhit<hit->GetRawTdcHit().GetNHits(); mhit++) {
@@ -372,31 +417,70 @@ Int_t THcDriftChamberPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
       Int_t rawnorefcorrtdc = hit->GetRawTdcHit().GetTimeRaw(mhit); // Get the ref time subtracted time
       Int_t rawtdc = hit->GetRawTdcHit().GetTime(mhit); // Get the ref time subtracted time
       Double_t time = - rawtdc*fNSperChan + fPlaneTimeZero - wire->GetTOffset(); // fNSperChan > 0 for 1877
-      new( (*fRawHits)[nextRawHit++] ) THcDCHit(wire, rawnorefcorrtdc,rawtdc, time, this);	
-     if(rawtdc < fTdcWinMin) {
-	// Increment early counter  (Actually late because TDC is backward)
-      } else if (rawtdc > fTdcWinMax) {
-	// Increment late count
-      } else {
-	if (First_Hit_In_Window) {
-	new( (*fHits)[nextHit++] ) THcDCHit(wire, rawnorefcorrtdc,rawtdc, time, this);
+      // The first in-window hit of the wire goes to fHits.  Early (actually
+      // late because TDC is backward), late and later hits to fOtherHits.
+      THcDCHit* rawhit;
+      if(First_Hit_In_Window && rawtdc >= fTdcWinMin && rawtdc <= fTdcWinMax) {
+	rawhit = new( (*fHits)[nextHit++] ) THcDCHit(wire, rawnorefcorrtdc,rawtdc, time, this);
 	First_Hit_In_Window = kFALSE;
-	}
+      } else {
+	rawhit = new( (*fOtherHits)[nextOtherHit++] ) THcDCHit(wire, rawnorefcorrtdc,rawtdc, time, this);
       }
+      // Same object in both lists, so start time subtraction and
+      // corrections of the hit also show up in fRawHits
+      fRawHits->AddLast(rawhit);
     }
     ihit++;
   }
+  if(fHotWireOccupancy > 0 && ++fNOccupancyEvents >= fHotWireNEvents) {
+    CheckHotWires();
+  }
   return(ihit);
 }
+
+//_____________________________________________________________________________
+void THcDriftChamberPlane::CheckHotWires()
+{
+  /**
+     Mask the wires that had hits in more than dc_hotwire_occupancy of
+     the last dc_hotwire_nevents events, then start counting again.
+     Hot wires stay masked for the rest of the run.
+  */
+  static const char* const here = "ProcessHits()";
+  for(Int_t i=0;i<fNWires;i++) {
+    if(fWireHitCount[i] > fHotWireOccupancy*fNOccupancyEvents
+       && !IsWireMasked(i+1)) {
+      MaskWire(i+1);
+      Warning(Here(here), "Wire %d hit in %d of %d events.  Masked as hot.",
+	      i+1, fWireHitCount[i], fNOccupancyEvents);
+    }
+    fWireHitCount[i] = 0;
+  }
+  fNOccupancyEvents = 0;
+}
 Int_t THcDriftChamberPlane::SubtractStartTime()
 {
+  /**
+     Subtract the hodoscope start time from the hit times, then convert
+     the times of all hits to drift distances in one call.
+  */
   Double_t StartTime = 0.0;
   if( fglHod ) StartTime = fglHod->GetStartTime();
-  for(Int_t ihit=0;ihit<GetNHits();ihit++) { 
+  Int_t nhits = GetNHits();
+  fHitTimes.resize(nhits);
+  fHitDists.resize(nhits);
+  for(Int_t ihit=0;ihit<nhits;ihit++) {
     THcDCHit *thishit = (THcDCHit*) fHits->At(ihit);
     Double_t temptime= thishit->GetTime()-StartTime;
     thishit->SetTime(temptime);
-    thishit->ConvertTimeToDist();
+    fHitTimes[ihit] = temptime;
+  }
+  if(nhits > 0) {
+    fTTDConv->ConvertTimesToDists(nhits, &fHitTimes[0], &fHitDists[0]);
+  }
+  for(Int_t ihit=0;ihit<nhits;ihit++) {
+    THcDCHit *thishit = (THcDCHit*) fHits->At(ihit);
+    thishit->SetDist(fHitDists[ihit]);
   }
   return 0;
 }
@@ -15,6 +15,7 @@
 #include "THaSubDetector.h"
 #include "TClonesArray.h"
 #include <cassert>
+#include <vector>
 
 class THaEvData;
 class THcDCWire;
@@ -54,7 +55,9 @@ public:
 
   Int_t         GetNHits() const { return fHits->GetLast()+1; }
   Int_t         GetNRawhits() const {return fNRawhits; }
+  Int_t         GetNMaskedHits() const {return fNMaskedHits; }
   TClonesArray* GetHits()  const { return fHits; }
+  TObjArray*    GetRawHits() const { return fRawHits; }
 
   Int_t        GetPlaneNum() const { return fPlaneNum; }
   Int_t        GetChamberNum() const { return fChamberNum; }
@@ -77,12 +80,18 @@ public:
   Int_t        GetReadoutTB() const { return fReadoutTB;}
   Int_t        GetVersion() const {return fVersion;}
 
+  Bool_t       IsWireMasked(Int_t wire) const
+  { return (fWireMask[(wire-1)>>5] >> ((wire-1)&31)) & 1; }
+  void         MaskWire(Int_t wire)
+  { fWireMask[(wire-1)>>5] |= 1U<<((wire-1)&31); }
+
 protected:
 
   TClonesArray* fParentHitList;
 
-  TClonesArray* fHits;
-  TClonesArray* fRawHits;
+  TClonesArray* fHits;		// First in-window hit of each wire
+  TClonesArray* fOtherHits;	// All other hits
+  TObjArray*    fRawHits;	// All hits, in fHits or fOtherHits
   TClonesArray* fWires;
 
   Int_t fVersion;
@@ -93,6 +102,8 @@ protected:
   Int_t fUsingTzeroPerWire;
   Int_t fUsingSigmaPerWire;
   Int_t fNRawhits;
+  Int_t fNMaskedHits;		// TDC hits on masked wires this event
+  Int_t fNBadWireHits;		// Raw hits with wire number out of range, whole run
   Int_t fNWires;
   Int_t fTdcWinMin;
   Int_t fTdcWinMax;
@@ -125,9 +136,19 @@ protected:
   virtual Int_t  DefineVariables( EMode mode = kDefine );
 
   THcDCTimeToDistConv* fTTDConv;  // Time-to-distance converter for this plane's wires
+  std::vector<Double_t> fHitTimes; // Hit times for the conversion to distance
+  std::vector<Double_t> fHitDists;
 
   THcHodoscope* fglHod;		// Hodoscope to get start time
 
+  std::vector<UInt_t> fWireMask;	// Bit per wire, set if hits are dropped
+  Double_t fHotWireOccupancy;	// Mask wires hit in more than this fraction
+  Int_t fHotWireNEvents;	// of this many events
+  Int_t fNOccupancyEvents;	// Events counted in fWireHitCount
+  std::vector<Int_t> fWireHitCount; // Events with a hit on each wire
+
+  void           CheckHotWires();
+
   ClassDef(THcDriftChamberPlane,0); // A single plane within a THcDriftChamber
 };
 #endif
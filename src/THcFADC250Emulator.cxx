@@ -0,0 +1,188 @@
+/** \class THcFADC250Emulator
+    \ingroup Base
+
+\brief Software version of the FADC250 pulse analysis
+
+Finds pulses in the raw samples of one FADC250 channel and computes
+the same quantities the firmware reports in pulse mode:
+
+- Pedestal: sum of the first NPED samples of the window.  If one of
+  them is above MAXPED, the pedestal is marked bad and the pedestal of
+  the last good window of the channel is used instead, if there is one.
+- Threshold crossing: first sample that is at least the threshold
+  above the pedestal average, followed by at least NSAT-1 more such
+  samples.  A shorter excursion above threshold is not a pulse.
+- Pulse integral: sum of the samples from NSB before to NSA after the
+  crossing (NSA+NSB samples, cut at the window edges).
+- Pulse peak: first local maximum at or after the crossing.
+- Pulse time: point on the leading edge halfway between the pedestal
+  average and the peak, interpolated between samples, in 1/64 of a
+  sample.
+
+The next pulse is searched for after the integration window, once the
+signal is below threshold again, up to NP pulses.
+
+Most samples are pedestal, so most of the time goes into looking for
+the next threshold crossing.  The threshold is turned into a sample
+value once per window, and the search compares blocks of fBlock
+samples at a time.  The compiler turns each block into a few vector
+compares.  Only a block that contains a crossing is looked at sample by
+sample.
+
+The results have the units of kPulsePedestal, kPulseIntegral,
+kPulsePeak and kPulseTime, so they can be passed to
+THcRawAdcHit::SetDataTimePedestalPeak unchanged.  If the parameter
+fadc_emulate is set, THcHitList uses this for FADC channels that have
+samples but no pulse data.  examples/fadcemubench.C checks it against
+a sample by sample version of the same analysis.
+
+*/
+#include "THcFADC250Emulator.h"
+
+#include <algorithm>
+
+using namespace std;
+
+THcFADC250Emulator::THcFADC250Emulator() :
+  fNSA(0), fNSB(0), fNPED(0), fNP(fMaxNPulses), fNSAT(1), fMaxPed(0),
+  fNPulses(0), fPedestal(0), fPedestalGood(kTRUE)
+{
+  /// Normal constructor.
+}
+
+THcFADC250Emulator::~THcFADC250Emulator()
+{
+  /// Destructor
+}
+
+void THcFADC250Emulator::SetParams(Int_t nsa, Int_t nsb, Int_t nped,
+				   Int_t np, Int_t nsat, Int_t maxped)
+{
+  /**
+\brief Set the firmware parameters
+
+\param[in] nsa Samples integrated after the threshold crossing
+\param[in] nsb Samples integrated before the threshold crossing
+\param[in] nped Samples used for the pedestal
+\param[in] np Maximum number of pulses, at most fMaxNPulses
+\param[in] nsat Samples above threshold needed for a pulse, at least 1
+\param[in] maxped Largest sample allowed in the pedestal, 0 to not check
+  */
+  fNSA = nsa;
+  fNSB = nsb;
+  fNPED = nped;
+  if(np > 0 && np < fMaxNPulses) {
+    fNP = np;
+  } else {
+    fNP = fMaxNPulses;
+  }
+  fNSAT = max(nsat, 1);
+  fMaxPed = maxped;
+}
+
+Int_t THcFADC250Emulator::FindAbove(const Int_t* samples, Int_t i,
+				    Int_t nsamples, Int_t level)
+{
+  /// First sample from i on that is at least level, nsamples if none
+  for(; i+fBlock <= nsamples; i += fBlock) {
+    Int_t any = 0;
+    for(Int_t j=0; j<fBlock; j++) {
+      any |= (samples[i+j] >= level);
+    }
+    if(any) break;
+  }
+  while(i < nsamples && samples[i] < level) i++;
+  return i;
+}
+
+Int_t THcFADC250Emulator::FindBelow(const Int_t* samples, Int_t i,
+				    Int_t nsamples, Int_t level)
+{
+  /// First sample from i on that is below level, nsamples if none
+  for(; i+fBlock <= nsamples; i += fBlock) {
+    Int_t any = 0;
+    for(Int_t j=0; j<fBlock; j++) {
+      any |= (samples[i+j] < level);
+    }
+    if(any) break;
+  }
+  while(i < nsamples && samples[i] >= level) i++;
+  return i;
+}
+
+Int_t THcFADC250Emulator::Analyze(const Int_t* samples, Int_t nsamples,
+				  Int_t threshold, Int_t lastpedestal)
+{
+  /**
+\brief Find the pulses in one window of samples
+
+\param[in] samples Raw samples
+\param[in] nsamples Number of samples
+\param[in] threshold Threshold above the pedestal average, in ADC channels
+\param[in] lastpedestal Pedestal of the last good window of the channel,
+           -1 if none
+\return Number of pulses found
+  */
+  fNPulses = 0;
+  fPedestal = 0;
+  fPedestalGood = kTRUE;
+  if(fNPED <= 0 || nsamples < fNPED) return 0;
+
+  Int_t pedsum = 0;
+  for(Int_t i=0; i<fNPED; i++) {
+    pedsum += samples[i];
+    if(fMaxPed > 0 && samples[i] > fMaxPed) fPedestalGood = kFALSE;
+  }
+  fPedestal = (fPedestalGood || lastpedestal < 0) ? pedsum : lastpedestal;
+
+  // A sample is above threshold if sample*NPED >= pedestal sum +
+  // threshold*NPED.  For integer samples that is sample >= level, with
+  // level the right side divided by NPED and rounded up.
+  Int_t scaled = fPedestal + threshold*fNPED;
+  const Int_t level = (scaled > 0 ? scaled + fNPED - 1 : scaled)/fNPED;
+
+  Int_t i = FindAbove(samples, 0, nsamples, level);
+  while(i < nsamples && fNPulses < fNP) {
+    Int_t nabove = 1;
+    while(nabove < fNSAT && i+nabove < nsamples
+	  && samples[i+nabove] >= level) nabove++;
+    if(nabove < fNSAT) {	// Too short for a pulse
+      i = FindAbove(samples, i+nabove, nsamples, level);
+      continue;
+    }
+    Int_t cross = i;
+
+    Int_t ipeak = cross;
+    while(ipeak+1 < nsamples && samples[ipeak+1] > samples[ipeak]) ipeak++;
+
+    Int_t lo = max(0, cross-fNSB);
+    Int_t hi = min(nsamples, cross+fNSA);
+    Int_t integral = 0;
+    for(Int_t j=lo; j<hi; j++) {
+      integral += samples[j];
+    }
+
+    // Both sides times 2*NPED: vmid is the halfway point between the
+    // pedestal average and the peak
+    Int_t vmid = samples[ipeak]*fNPED + fPedestal;
+    Int_t k = ipeak;
+    while(k > 0 && 2*samples[k-1]*fNPED >= vmid) k--;
+    Int_t time = 0;
+    if(k > 0) {
+      time = 64*(k-1) + (64*(vmid - 2*samples[k-1]*fNPED))
+	/(2*(samples[k] - samples[k-1])*fNPED);
+    }
+
+    fPulseIntegral[fNPulses] = integral;
+    fPulseTime[fNPulses] = time;
+    fPulsePeak[fNPulses] = samples[ipeak];
+    fNPulses++;
+
+    // Rearm after the integration window once below threshold
+    i = FindBelow(samples, max(hi, ipeak+1), nsamples, level);
+    i = FindAbove(samples, i, nsamples, level);
+  }
+  return fNPulses;
+}
+
+ClassImp(THcFADC250Emulator)
@@ -0,0 +1,57 @@
+#ifndef ROOT_THcFADC250Emulator
+#define ROOT_THcFADC250Emulator
+
+//////////////////////////////////////////////////////////////////////////
+//
+// THcFADC250Emulator
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "TObject.h"
+
+class THcFADC250Emulator : public TObject {
+
+public:
+
+  THcFADC250Emulator();
+  virtual ~THcFADC250Emulator();
+
+  void  SetParams(Int_t nsa, Int_t nsb, Int_t nped, Int_t np, Int_t nsat,
+		  Int_t maxped);
+  Int_t Analyze(const Int_t* samples, Int_t nsamples, Int_t threshold,
+		Int_t lastpedestal=-1);
+
+  Int_t  GetNPulses() const { return fNPulses; }
+  Int_t  GetPedestal() const { return fPedestal; }
+  Bool_t IsPedestalGood() const { return fPedestalGood; }
+  Int_t  GetPulseIntegral(Int_t ipulse) const { return fPulseIntegral[ipulse]; }
+  Int_t  GetPulseTime(Int_t ipulse) const { return fPulseTime[ipulse]; }
+  Int_t  GetPulsePeak(Int_t ipulse) const { return fPulsePeak[ipulse]; }
+
+  static const Int_t fMaxNPulses = 4;
+  static const Int_t fBlock = 16; // Samples compared at once in the search
+
+protected:
+
+  static Int_t FindAbove(const Int_t* samples, Int_t i, Int_t nsamples,
+			 Int_t level);
+  static Int_t FindBelow(const Int_t* samples, Int_t i, Int_t nsamples,
+			 Int_t level);
+
+  Int_t fNSA;			// Samples integrated after threshold crossing
+  Int_t fNSB;			// Samples integrated before threshold crossing
+  Int_t fNPED;			// Samples at start of window used for pedestal
+  Int_t fNP;			// Maximum number of pulses
+  Int_t fNSAT;			// Samples above threshold needed for a pulse
+  Int_t fMaxPed;		// Largest pedestal sample, 0 to not check
+
+  Int_t fNPulses;
+  Int_t fPedestal;		// Sum of the fNPED pedestal samples
+  Bool_t fPedestalGood;		// No pedestal sample above fMaxPed
+  Int_t fPulseIntegral[fMaxNPulses];
+  Int_t fPulseTime[fMaxNPulses]; // In 1/64 of a sample
+  Int_t fPulsePeak[fMaxNPulses];
+
+  ClassDef(THcFADC250Emulator,0);  // Software FADC250 pulse analysis
+};
+#endif
@@ -10,5 +10,8 @@
 
 R__EXTERN class THcParmList*  gHcParms;      //List of global symbolic variables
 R__EXTERN class THcDetectorMap*  gHcDetectorMap;   //Cached map file
+R__EXTERN class THcRefTimeCache* gHcRefTimeCache;  //Reference times of current event
+R__EXTERN class THcChannelOwnerMap* gHcChannelOwnerMap;  //Channels of all hit lists
+R__EXTERN class THcDiagnostics* gHcDiagnostics;  //Event loop warnings
 
 #endif
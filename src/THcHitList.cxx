@@ -1,4 +1,3 @@
-// Remove this line to restore missing ADC reference time messages
 /** \class THcHitList
     \ingroup Base
 
@@ -16,24 +15,40 @@
 #include "THaGlobals.h"
 #include "THcGlobals.h"
 #include "THcParmList.h"
+#include "THcRefTimeCache.h"
+#include "THcChannelOwnerMap.h"
+#include "THcFADC250Emulator.h"
+#include "THcDiagnostics.h"
+#include "THcRawHodoHit.h"
+#include "THcRawShowerHit.h"
+#include "THcRawDCHit.h"
+#include "THcTrigRawHit.h"
 #include "TList.h"
 
+#include <algorithm>
+
 using namespace std;
 
-#define SUPPRESSMISSINGADCREFTIMEMESSAGES 1
-THcHitList::THcHitList() : fMap(0), fTISlot(0), fDisableSlipCorrection(kFALSE)
+THcHitList::THcHitList() : fMap(0), fTISlot(0), fDisableSlipCorrection(kFALSE),
+  fChannelOwner(-1), fHaveMultifunction(kFALSE)
 {
   /// Normal constructor.
 
   fRawHitList = NULL;
+  fRawDataArena = NULL;
   fPSE125 = NULL;
+  fFADCEmulate = 0;
+  fFADCEmulator = NULL;
   fFADCSlotMap.clear();
 
 }
 
 THcHitList::~THcHitList() {
   /// Destructor
+  if(gHcChannelOwnerMap) gHcChannelOwnerMap->Unregister(fChannelOwner);
   delete fRawHitList;
+  delete fRawDataArena;
+  delete fFADCEmulator;
   delete [] fSignalTypes;
 }
 /**
@@ -62,7 +77,19 @@ void THcHitList::InitHitList(THaDetMap* detmap,
 			     Int_t tdcref_cut, Int_t adcref_cut) {
   cout << "InitHitList: " << hitclass << " RefTimeCuts: " << tdcref_cut << " " << adcref_cut << endl;
   fRawHitList = new TClonesArray(hitclass, maxhits);
+  fRawDataArena = new THcRawDataArena;
   fRawHitClass = fRawHitList->GetClass();
+  if(fRawHitClass->InheritsFrom("THcRawHodoHit")) {
+    fRawHitKind = kHodoHit;
+  } else if(fRawHitClass->InheritsFrom("THcRawShowerHit")) {
+    fRawHitKind = kShowerHit;
+  } else if(fRawHitClass->InheritsFrom("THcRawDCHit")) {
+    fRawHitKind = kDCHit;
+  } else if(fRawHitClass->InheritsFrom("THcTrigRawHit")) {
+    fRawHitKind = kTrigHit;
+  } else {
+    fRawHitKind = kGenericHit;
+  }
   fNMaxRawHits = maxhits;
   fNRawHits = 0;
 
@@ -91,6 +118,8 @@ void THcHitList::InitHitList(THaDetMap* detmap,
   for(UInt_t isig=0;isig<fNSignals;isig++) {
     fSignalTypes[isig] = rawhit->GetSignalType(isig);
   }
+  // FADC samples are read on first use unless the detector asks for them
+  fWantSamples.assign(fNSignals, kFALSE);
 
   fdMap = detmap;
 
@@ -112,6 +141,7 @@ void THcHitList::InitHitList(THaDetMap* detmap,
     RefIndexMap map;
     map.defined = kFALSE;
     map.hashit = kFALSE;
+    map.multifunction = kFALSE;
     fRefIndexMaps.push_back(map);
   }
   // Put the refindex mapping information in the vector
@@ -166,12 +196,151 @@ void THcHitList::InitHitList(THaDetMap* detmap,
   }
   fHaveFADCInfo = kFALSE;
 
+  // Software pulse analysis of raw sample mode data, on request
+  fFADCEmulate = 0;
+  DBRequest list[]={
+    {"fadc_emulate", &fFADCEmulate, kInt, 0, 1},
+    {0}
+  };
+  gHcParms->LoadParmValues((DBRequest*)&list, "");
+  if(fFADCEmulate && !fFADCEmulator) fFADCEmulator = new THcFADC250Emulator;
+
   fNTDCRef_miss = 0;
   fNADCRef_miss = 0;
 
+  // Reference times are shared by all detectors through one cache
+  if(!gHcRefTimeCache) gHcRefTimeCache = new THcRefTimeCache;
+  // and the event data is walked once for all detectors
+  if(!gHcChannelOwnerMap) gHcChannelOwnerMap = new THcChannelOwnerMap;
+  // Warnings from the event loop are counted and sampled, not printed
+  if(!gHcDiagnostics) gHcDiagnostics = new THcDiagnostics;
+  fDiagTDCRefMiss = gHcDiagnostics->Register("hitlist_tdcref_miss",
+					     "Missing TDC reference times");
+  fDiagADCRefMiss = gHcDiagnostics->Register("hitlist_adcref_miss",
+					     "Missing ADC reference times");
+  fDiagTrigTimeShift = gHcDiagnostics->Register("hitlist_trig_time_shift",
+						"Big ADC trigger time shifts");
+
+  BuildHitSlotIndex();
+  BuildChannelTable();
+
   //  DisableSlipCorrection();
 }
 
+void THcHitList::ResetEventCaches()
+{
+  /**
+\brief Empty the event level caches shared by all hit lists
+
+Must be called once per event, before any detector decodes it.
+THcAnalyzer does this before the apparatuses decode.  Programs that
+call the detectors' Decode themselves must call it for every event.
+  */
+  if(gHcRefTimeCache) gHcRefTimeCache->Reset();
+  if(gHcChannelOwnerMap) gHcChannelOwnerMap->Reset();
+}
+
+void THcHitList::BuildHitSlotIndex()
+{
+  /**
+\brief Build the dense (plane, counter) to hit slot index
+
+Each plane gets a contiguous block of slots covering the range of
+counters the detector map assigns to it.  Slots are numbered in
+increasing (plane, counter) order, so walking fired slots in
+increasing order yields a hit list that is already sorted.
+  */
+  Int_t maxplane = -1;
+  for (Int_t i=0; i < fdMap->GetSize(); i++) {
+    THaDetMap::Module* d = fdMap->GetModule(i);
+    if(d->plane >= 1000) continue; // Reference time definition
+    if(d->plane < 0) {
+      cout << "Hitlist: Invalid plane " << d->plane << " for " <<
+	" (" << d->crate << ", " << d->slot <<
+	", " << d->lo << ")" << endl;
+      continue;
+    }
+    if(d->plane > maxplane) maxplane = d->plane;
+  }
+  Int_t nplanes = maxplane+1;
+  fPlaneCounterMin.assign(nplanes, kMaxInt);
+  std::vector<Int_t> countermax(nplanes, -kMaxInt);
+  for (Int_t i=0; i < fdMap->GetSize(); i++) {
+    THaDetMap::Module* d = fdMap->GetModule(i);
+    Int_t plane = d->plane;
+    if(plane >= 1000 || plane < 0) continue;
+    // Counters of this module run from first to first+hi-lo,
+    // whether or not the channel order is reversed
+    Int_t cmin = d->first;
+    Int_t cmax = d->first + d->hi - d->lo;
+    if(cmin < fPlaneCounterMin[plane]) fPlaneCounterMin[plane] = cmin;
+    if(cmax > countermax[plane]) countermax[plane] = cmax;
+  }
+  fPlaneSlotOffset.assign(nplanes, 0);
+  Int_t nslots = 0;
+  for(Int_t plane=0; plane<nplanes; plane++) {
+    fPlaneSlotOffset[plane] = nslots;
+    if(countermax[plane] >= fPlaneCounterMin[plane]) {
+      nslots += countermax[plane] - fPlaneCounterMin[plane] + 1;
+    }
+  }
+  fSlotPlane.assign(nslots, 0);
+  fSlotCounter.assign(nslots, 0);
+  for(Int_t plane=0; plane<nplanes; plane++) {
+    for(Int_t counter=fPlaneCounterMin[plane]; counter<=countermax[plane]; counter++) {
+      Int_t hitslot = GetHitSlot(plane, counter);
+      fSlotPlane[hitslot] = plane;
+      fSlotCounter[hitslot] = counter;
+    }
+  }
+  fSlotHitIndex.assign(nslots, -1);
+  fFiredSlots.clear();
+  fFiredSlots.reserve(nslots);
+}
+
+void THcHitList::BuildChannelTable()
+{
+  /**
+\brief Build the (crate, slot, chan) dispatch table
+
+Flattens the detector map into one ChannelEntry per mapped channel,
+holding the plane, counter, signal, signal type, reference channel
+information and hit slot.  Each entry is registered with
+gHcChannelOwnerMap, which returns the fired entries of each event.
+The multifunction flag needs the event data and is filled in at the
+first event.
+  */
+  fChannelEntries.clear();
+  fHaveMultifunction = kFALSE;
+  gHcChannelOwnerMap->Unregister(fChannelOwner);
+  fChannelOwner = gHcChannelOwnerMap->Register();
+
+  // One entry per mapped channel, in detector map order
+  for (Int_t i=0; i < fdMap->GetSize(); i++) {
+    THaDetMap::Module* d = fdMap->GetModule(i);
+    if(d->plane >= 1000 || d->plane < 0) continue; // Skip reference times
+    for(Int_t chan=d->lo; chan<=d->hi; chan++) {
+      ChannelEntry entry;
+      entry.crate = d->crate;
+      entry.slot = d->slot;
+      entry.chan = chan;
+      entry.plane = d->plane;
+      entry.counter = d->reverse ? d->first + d->hi - chan : d->first + chan - d->lo;
+      entry.signal = d->signal;
+      entry.signaltype = (d->signal >= 0 && (UInt_t) d->signal < fNSignals) ?
+	fSignalTypes[d->signal] : THcRawHit::kUndefined;
+      entry.refchan = d->refchan;
+      entry.refindex = d->refindex;
+      entry.hitslot = GetHitSlot(entry.plane, entry.counter);
+      entry.multifunction = kFALSE;
+      gHcChannelOwnerMap->AddChannel(fChannelOwner, d->crate, d->slot, chan,
+				     fChannelEntries.size());
+      fChannelEntries.push_back(entry);
+    }
+  }
+  fFADCLastPedestal.assign(fChannelEntries.size(), -1);
+}
+
 /**
 
 \brief Populate the hitlist from the raw event data.
@@ -180,7 +349,9 @@ Clears the hit list then, finds all populated channels belonging to the detector
 sort it into the hitlist.  A given counter in the detector can have
 at most one entry in the hit list.  However, the raw "hit" can contain
 multiple signal types (e.g. ADC+, ADC-, TDC+, TDC-), or multiplehits for multihit tdcs.
-The hit list is sorted (by plane, counter) after filling.
+The fired channels are first mapped to their (plane, counter) hit slots.
+Hits are then created in slot order, so the hit list comes out sorted
+by (plane, counter) without a separate sort.
 
 */
 Int_t THcHitList::DecodeToHitList( const THaEvData& evdata, Bool_t suppresswarnings ) {
@@ -216,298 +387,380 @@ Int_t THcHitList::DecodeToHitList( const THaEvData& evdata, Bool_t suppresswarni
       }
     }
   }
+  if(!fHaveMultifunction) {	// Resolve module types in the channel table
+    for (UInt_t ientry=0; ientry < fChannelEntries.size(); ientry++) {
+      ChannelEntry& entry = fChannelEntries[ientry];
+      entry.multifunction = evdata.IsMultifunction(entry.crate, entry.slot);
+    }
+    for(Int_t i=0;i<fNRefIndex;i++) {
+      if(fRefIndexMaps[i].defined) {
+	fRefIndexMaps[i].multifunction =
+	  evdata.IsMultifunction(fRefIndexMaps[i].crate, fRefIndexMaps[i].slot);
+      }
+    }
+    fHaveMultifunction = kTRUE;
+  }
   if(fDisableSlipCorrection) fTISlot = -1;
     
-  Int_t titime = 0;
   if(fTISlot>0) {
-#define FUDGE 7
-    titime = evdata.GetData(fTICrate, fTISlot, 2, 0)-FUDGE;
-    // Need to get the FADC time for all modules in this crate
-    // that have hits.  Make a map with these times.
+    // FADC trigger time shifts of the modules with hits.  Kept only for
+    // the trigger time shift report, the shifts come from gHcRefTimeCache.
     fTrigTimeShiftMap.clear();
-    //cout << "TI Crate: " << fTICrate << " " << (UInt_t) titime << endl;
   }
 
   // cout << " Clearing TClonesArray " << endl;
   fRawHitList->Clear( );
+  fRawDataArena->Clear();
   fNRawHits = 0;
   Bool_t tdcref_miss = kFALSE;
   Bool_t adcref_miss = kFALSE;
 
-  // Get the indexed reference times for this event
+  // Get the indexed reference times for this event.  The reference
+  // channels are shared with other detectors, so ask the event level cache.
   for(Int_t i=0;i<fNRefIndex;i++) {
     if(fRefIndexMaps[i].defined) {
-      
-      if(evdata.IsMultifunction(fRefIndexMaps[i].crate,
-				fRefIndexMaps[i].slot)) { // Multifunction module (e.g. FADC)
-	// Make sure at least one pulse
-	Int_t nrefhits = evdata.GetNumEvents(Decoder::kPulseTime,
-					     fRefIndexMaps[i].crate,
-					     fRefIndexMaps[i].slot,
-					     fRefIndexMaps[i].channel);
-	Int_t timeshift=0;
-	if(fTISlot>0) {		// Get the trigger time for this module
-	  if(fTrigTimeShiftMap.find(fRefIndexMaps[i].slot)
-	     == fTrigTimeShiftMap.end()) { // 
-	    if(fFADCSlotMap.find(fRefIndexMaps[i].slot) != fFADCSlotMap.end()) {
-	      fTrigTimeShiftMap[fRefIndexMaps[i].slot]
-		= fFADCSlotMap[fRefIndexMaps[i].slot]->GetTriggerTime() - titime;
-	    }
-	    timeshift = fTrigTimeShiftMap[fRefIndexMaps[i].slot];
-	  }
-	}
-	fRefIndexMaps[i].hashit = kFALSE;
-	Bool_t goodreftime=kFALSE;
-	Int_t reftime = 0;
-	for(Int_t ihit=0; ihit<nrefhits; ihit++) {
-	  reftime = evdata.GetData(Decoder::kPulseTime,fRefIndexMaps[i].crate,
-				   fRefIndexMaps[i].slot, fRefIndexMaps[i].channel,ihit);
-	  reftime += 64*timeshift;
-	  if(reftime >= fADC_RefTimeCut) {
-	    goodreftime = kTRUE;
-	    break;
-	  }
-	}
-	if(goodreftime || (nrefhits>0 && fADC_RefTimeBest)) {
-	  fRefIndexMaps[i].reftime = reftime;
-	  fRefIndexMaps[i].hashit = kTRUE;
-	}
+      Int_t reftime = 0;
+      if(fRefIndexMaps[i].multifunction) { // Multifunction module (e.g. FADC)
+	Int_t timeshift = GetTrigTimeShift(evdata, fRefIndexMaps[i].slot);
+	fRefIndexMaps[i].hashit =
+	  gHcRefTimeCache->GetADCRefTime(evdata, fRefIndexMaps[i].crate,
+					 fRefIndexMaps[i].slot,
+					 fRefIndexMaps[i].channel,
+					 fADC_RefTimeCut, fADC_RefTimeBest,
+					 timeshift, reftime);
       } else {			// Assume this is a TDC
-	Int_t nrefhits = evdata.GetNumHits(fRefIndexMaps[i].crate,
-					   fRefIndexMaps[i].slot,
-					   fRefIndexMaps[i].channel);
-	fRefIndexMaps[i].hashit = kFALSE;
-	// Only take first hit in this reference channel that is bigger
-	// then fTDC_RefTimeCut
-	Bool_t goodreftime=kFALSE;
-	Int_t reftime = 0;
-	for(Int_t ihit=0; ihit<nrefhits; ihit++) {
-	  reftime = evdata.GetData(fRefIndexMaps[i].crate,fRefIndexMaps[i].slot,
-				   fRefIndexMaps[i].channel,ihit);
-	  if(reftime >= fTDC_RefTimeCut) {
-	    goodreftime = kTRUE;
-	    break;
-	  }
-	}
-	if(goodreftime || (nrefhits>0 && fTDC_RefTimeBest)) {
-	    fRefIndexMaps[i].reftime = reftime;
-	    fRefIndexMaps[i].hashit = kTRUE;
-	}
+	fRefIndexMaps[i].hashit =
+	  gHcRefTimeCache->GetTDCRefTime(evdata, fRefIndexMaps[i].crate,
+					 fRefIndexMaps[i].slot,
+					 fRefIndexMaps[i].channel,
+					 fTDC_RefTimeCut, fTDC_RefTimeBest,
+					 reftime);
+      }
+      if(fRefIndexMaps[i].hashit) {
+	fRefIndexMaps[i].reftime = reftime;
       }
     }
   }
-  for ( Int_t i=0; i < fdMap->GetSize(); i++ ) {
-    THaDetMap::Module* d = fdMap->GetModule(i);
-    
-    // Loop over all channels that have a hit.
-    //    cout << "Crate/Slot: " << d->crate << "/" << d->slot << endl;
-    Int_t plane = d->plane;
-    if (plane >= 1000) continue; // Skip reference times
-    Int_t signal = d->signal;
-    UInt_t signaltype = fSignalTypes[signal];
-    Bool_t multifunction = evdata.IsMultifunction(d->crate, d->slot);
-    // Should probably get the Decoder::Module object and use it's
-    // methods.  Saving a THaEvData::GetModule call every time
-
-    for ( Int_t j=0; j < evdata.GetNumChan( d->crate, d->slot); j++) {
-      THcRawHit* rawhit=0;
-
-      Int_t chan = evdata.GetNextChan( d->crate, d->slot, j );
-      if( chan < d->lo || chan > d->hi ) continue;     // Not one of my channels
-
-      // Need to convert crate, slot, chan into plane, counter, signal
-      // Search hitlist for this plane,counter,signal
-      Int_t counter = d->reverse ? d->first + d->hi - chan : d->first + chan - d->lo;
-      //cout << d->crate << " " << d->slot << " " << chan << " " << plane << " "
-      // << counter << " " << signal << endl;
-      // Search hit list for plane and counter
-      // We could do sorting
-      UInt_t thishit = 0;
-      while(thishit < fNRawHits) {
-	rawhit = (THcRawHit*) (*fRawHitList)[thishit];
-	if (plane == rawhit->fPlane
-	    && counter == rawhit->fCounter) {
-	  // cout << "Found as " << thishit << "/" << fNRawHits << endl;
-	  break;
+  // Get the fired channels from the event level map, which walks the
+  // event data once for all detectors, and find the (plane, counter)
+  // slots they belong to
+  const vector<Int_t>& firedchannels =
+    gHcChannelOwnerMap->GetFiredChannels(evdata, fChannelOwner);
+  fFiredSlots.clear();
+  for (UInt_t ifired=0; ifired < firedchannels.size(); ifired++) {
+    Int_t hitslot = fChannelEntries[firedchannels[ifired]].hitslot;
+    if(fSlotHitIndex[hitslot] < 0) {
+      fSlotHitIndex[hitslot] = 0; // Index assigned below
+      fFiredSlots.push_back(hitslot);
+    }
+  }
+
+  // Create one hit per fired slot, in (plane, counter) order
+  std::sort(fFiredSlots.begin(), fFiredSlots.end());
+  for (UInt_t k=0; k < fFiredSlots.size(); k++) {
+    Int_t hitslot = fFiredSlots[k];
+    THcRawHit* rawhit = (THcRawHit*) fRawHitList->ConstructedAt(k,"");
+    rawhit->fPlane = fSlotPlane[hitslot];
+    rawhit->fCounter = fSlotCounter[hitslot];
+    rawhit->SetArena(fRawDataArena);
+    fSlotHitIndex[hitslot] = k;
+  }
+  fNRawHits = fFiredSlots.size();
+
+  // Fill the hits.  Hit classes known here are filled through
+  // THcRawHitParts, without the virtual Set methods.
+  switch(fRawHitKind) {
+  case kHodoHit:
+    FillHits<THcRawHodoHit>(evdata, firedchannels, suppresswarnings,
+			    tdcref_miss, adcref_miss);
+    break;
+  case kShowerHit:
+    FillHits<THcRawShowerHit>(evdata, firedchannels, suppresswarnings,
+			      tdcref_miss, adcref_miss);
+    break;
+  case kDCHit:
+    FillHits<THcRawDCHit>(evdata, firedchannels, suppresswarnings,
+			  tdcref_miss, adcref_miss);
+    break;
+  case kTrigHit:
+    FillHits<THcTrigRawHit>(evdata, firedchannels, suppresswarnings,
+			    tdcref_miss, adcref_miss);
+    break;
+  default:
+    FillHits<THcRawHit>(evdata, firedchannels, suppresswarnings,
+			tdcref_miss, adcref_miss);
+    break;
+  }
+#if 1
+  if(fTISlot>0) {
+    //    cout << "TI ROC: " << fTICrate << "   TI Time: " << titime << endl;
+    map<Int_t, Int_t>::iterator it;
+    for(it=fTrigTimeShiftMap.begin(); it!=fTrigTimeShiftMap.end(); it++) {
+      if(it->second < -3 || it->second > 3) {
+	if(gHcDiagnostics->Count(fDiagTrigTimeShift)) {
+	  gHcDiagnostics->Keep(fDiagTrigTimeShift,
+			       Form("Big ADC Trigger Time Shift, ROC %d slot %d: %d (event %d)",
+				    fTICrate, it->first, it->second, evdata.GetEvNum()));
 	}
-	thishit++;
       }
+    }
+  }
+#endif    
+  // Reset the slot index for the next event
+  for (UInt_t k=0; k < fFiredSlots.size(); k++) {
+    fSlotHitIndex[fFiredSlots[k]] = -1;
+  }
 
-      if(thishit == fNRawHits) {
-	rawhit = (THcRawHit*) fRawHitList->ConstructedAt(thishit,"");
-	fNRawHits++;
-	rawhit->fPlane = plane;
-	rawhit->fCounter = counter;
-      }
+  fNTDCRef_miss += (tdcref_miss ? 1 : 0);
+  fNADCRef_miss += (adcref_miss ? 1 : 0);
+  return fNRawHits;		// Does anything care what is returned
+}
 
-      // Get the data from this channel
-      // Allow for multiple hits
-      if(signaltype == THcRawHit::kTDC || !multifunction) {
-	Int_t nMHits = evdata.GetNumHits(d->crate, d->slot, chan);
-	for (Int_t mhit = 0; mhit < nMHits; mhit++) {
-	  Int_t data = evdata.GetData( d->crate, d->slot, chan, mhit);
-	  // cout << "Signal " << signal << "=" << data << endl;
-	  rawhit->SetData(signal,data);
-	}
-	// Get the reference time.
-	if(d->refchan >= 0) {
-	  Int_t nrefhits = evdata.GetNumHits(d->crate,d->slot,d->refchan);
-	  Bool_t goodreftime=kFALSE;
-	  Int_t reftime=0;
-	  for(Int_t ihit=0; ihit<nrefhits; ihit++) {
-	    reftime = evdata.GetData(d->crate, d->slot, d->refchan, ihit);
-	    if(reftime >= fTDC_RefTimeCut) {
-	      goodreftime = kTRUE;
-	      break;
-	    }
-	  }
-	  // If RefTimeBest flag set, take the last hit if none of the
-	  // hits make the RefTimeCut
-	  if(goodreftime || (nrefhits>0 && fTDC_RefTimeBest)) {
-	    rawhit->SetReference(signal, reftime);
-	  } else if (!suppresswarnings) {
-	    cout << "HitList(event=" << evdata.GetEvNum() << "): refchan " << d->refchan <<
-	      " missing for (" << d->crate << ", " << d->slot <<
-	      ", " << chan << ")" << endl;
-	      tdcref_miss = kTRUE;
+// Store a reference time or a pulse in the part of the hit a signal
+// belongs to, through the virtual THcRawHit method if the part is unknown
+template<class Hit>
+static inline void SetHitReference(Hit& rawhit, THcRawAdcHit* adc,
+				   THcRawTdcHit* tdc, Int_t signal,
+				   Int_t reftime)
+{
+  if(tdc) tdc->SetRefTime(reftime);
+  else if(adc) adc->SetRefTime(reftime);
+  else rawhit.SetReference(signal, reftime);
+}
+
+template<class Hit>
+static inline void SetHitPulse(Hit& rawhit, THcRawAdcHit* adc, Int_t signal,
+			       Int_t data, Int_t time, Int_t pedestal,
+			       Int_t peak)
+{
+  if(adc) adc->SetDataTimePedestalPeak(data, time, pedestal, peak);
+  else rawhit.SetDataTimePedestalPeak(signal, data, time, pedestal, peak);
+}
+
+template<class Hit>
+void THcHitList::FillHits(const THaEvData& evdata, const vector<Int_t>& firedchannels,
+			  Bool_t suppresswarnings, Bool_t& tdcref_miss,
+			  Bool_t& adcref_miss)
+{
+  /**
+\brief Fill the hits created by DecodeToHitList from the fired channels
+
+Instantiated for each raw hit class.  The ADC or TDC part of the hit
+a signal belongs to is looked up once per channel with
+THcRawHitParts<Hit>, and samples, hits and pulses are stored in it
+directly.  The virtual THcRawHit methods are only used for parts the
+hit class does not expose.
+  */
+  for (UInt_t ifired=0; ifired < firedchannels.size(); ifired++) {
+    const ChannelEntry* d = &fChannelEntries[firedchannels[ifired]];
+    Int_t chan = d->chan;
+    Int_t signal = d->signal;
+    // Signals out of range were reported in InitHitList.  Skip them here,
+    // they would index past the per signal arrays.
+    if(signal < 0 || (UInt_t) signal >= fNSignals) continue;
+    Int_t signaltype = d->signaltype;
+    Bool_t multifunction = d->multifunction;
+    Hit* rawhit = static_cast<Hit*>((*fRawHitList)[fSlotHitIndex[d->hitslot]]);
+    THcRawAdcHit* adc = THcRawHitParts<Hit>::Adc(*rawhit, signal);
+    THcRawTdcHit* tdc = THcRawHitParts<Hit>::Tdc(*rawhit, signal);
+    // Get the data from this channel
+    // Allow for multiple hits
+    if(signaltype == THcRawHit::kTDC || !multifunction) {
+      Int_t nMHits = evdata.GetNumHits(d->crate, d->slot, chan);
+      for (Int_t mhit = 0; mhit < nMHits; mhit++) {
+	Int_t data = evdata.GetData( d->crate, d->slot, chan, mhit);
+	// cout << "Signal " << signal << "=" << data << endl;
+	if(tdc) tdc->SetTime(data);
+	else if(adc) adc->SetData(data);
+	else rawhit->SetData(signal,data);
+      }
+      // Get the reference time.
+      if(d->refchan >= 0) {
+	// If RefTimeBest flag set, take the last hit if none of the
+	// hits make the RefTimeCut
+	Int_t reftime=0;
+	if(gHcRefTimeCache->GetTDCRefTime(evdata, d->crate, d->slot, d->refchan,
+					  fTDC_RefTimeCut, fTDC_RefTimeBest,
+					  reftime)) {
+	  SetHitReference(*rawhit, adc, tdc, signal, reftime);
+	} else if (!suppresswarnings) {
+	  if(gHcDiagnostics->Count(fDiagTDCRefMiss)) {
+	    gHcDiagnostics->Keep(fDiagTDCRefMiss,
+				 Form("HitList(event=%d): refchan %d missing for (%d, %d, %d)",
+				      evdata.GetEvNum(), d->refchan, d->crate, d->slot, chan));
 	  }
-	} else {
-	  if(d->refindex >=0 && d->refindex < fNRefIndex) {
-	    if(fRefIndexMaps[d->refindex].hashit) {
-	      rawhit->SetReference(signal, fRefIndexMaps[d->refindex].reftime);
-	    } else {
-	      if(!suppresswarnings) {
-		cout << "HitList(event=" << evdata.GetEvNum() << "): refindex " << d->refindex <<
-		  " (" << fRefIndexMaps[d->refindex].crate <<
-		  ", " << fRefIndexMaps[d->refindex].slot <<
-		  ", " << fRefIndexMaps[d->refindex].channel << ")" <<
-		  " missing for (" << d->crate << ", " << d->slot <<
-		  ", " << chan << ")" << endl;
-		tdcref_miss = kTRUE;
+	  tdcref_miss = kTRUE;
+	}
+      } else {
+	if(d->refindex >=0 && d->refindex < fNRefIndex) {
+	  if(fRefIndexMaps[d->refindex].hashit) {
+	    SetHitReference(*rawhit, adc, tdc, signal, fRefIndexMaps[d->refindex].reftime);
+	  } else {
+	    if(!suppresswarnings) {
+	      if(gHcDiagnostics->Count(fDiagTDCRefMiss)) {
+		gHcDiagnostics->Keep(fDiagTDCRefMiss,
+				     Form("HitList(event=%d): refindex %d (%d, %d, %d) missing for (%d, %d, %d)",
+					  evdata.GetEvNum(), d->refindex,
+					  fRefIndexMaps[d->refindex].crate,
+					  fRefIndexMaps[d->refindex].slot,
+					  fRefIndexMaps[d->refindex].channel,
+					  d->crate, d->slot, chan));
 	      }
+	      tdcref_miss = kTRUE;
 	    }
 	  }
 	}
-      } else {			// This is a Flash ADC
-
-        if (fPSE125) {
-	  if(!fHaveFADCInfo) {
-	    fNSA = fPSE125->GetNSA(d->crate);
-	    fNSB = fPSE125->GetNSB(d->crate);
-	    fNPED = fPSE125->GetNPED(d->crate);
-	    fHaveFADCInfo = kTRUE;
-	  }
-	  // Set F250 parameters.
-          rawhit->SetF250Params(fNSA, fNSB, fNPED);
-        }
+      }
+    } else {			// This is a Flash ADC
+
+      if (fPSE125) {
+	if(!fHaveFADCInfo) {
+	  fNSA = fPSE125->GetNSA(d->crate);
+	  fNSB = fPSE125->GetNSB(d->crate);
+	  fNPED = fPSE125->GetNPED(d->crate);
+	  fNP = fPSE125->GetNP(d->crate);
+	  fNSAT = fPSE125->GetNSAT(d->crate);
+	  fMAXPED = fPSE125->GetMAXPED(d->crate);
+	  fHaveFADCInfo = kTRUE;
+	}
+	// Set F250 parameters.
+	rawhit->SetF250Params(fNSA, fNSB, fNPED);
+      }
 	
-	// Copy the samples
+      // Copy the samples if the detector uses them.  Otherwise the hit
+      // only remembers where to find them.
+      Bool_t deferred = kFALSE;
+      if(!fWantSamples[signal]) {
+	if(adc) {
+	  adc->SetSampleSource(&evdata, d->crate, d->slot, chan);
+	  deferred = kTRUE;
+	} else {
+	  deferred = rawhit->SetSampleSource(signal, &evdata, d->crate, d->slot, chan);
+	}
+      }
+      if(!deferred) {
 	Int_t nsamples=evdata.GetNumEvents(Decoder::kSampleADC, d->crate, d->slot, chan);
 
 	// If nsamples comes back zero, may want to suppress further attempts to
 	// get sample data for this or all modules
 	for (Int_t isamp=0;isamp<nsamples;isamp++) {
-	  rawhit->SetSample(signal,evdata.GetData(Decoder::kSampleADC, d->crate, d->slot, chan, isamp));
+	  Int_t sample = evdata.GetData(Decoder::kSampleADC, d->crate, d->slot, chan, isamp);
+	  if(adc) adc->SetSample(sample);
+	  else rawhit->SetSample(signal,sample);
 	}
-	// Now get the pulse mode data
-	// Pulse area will go into regular SetData, others will use special hit methods
-	Int_t npulses=evdata.GetNumEvents(Decoder::kPulseIntegral, d->crate, d->slot, chan);
-	// Assume that the # of pulses for kPulseTime, kPulsePeak and kPulsePedestal are same;
-	Int_t timeshift=0;
-	if(fTISlot>0) {		// Get the trigger time for this module
-	  if(fTrigTimeShiftMap.find(d->slot)
-	     == fTrigTimeShiftMap.end()) { // 
-	    if(fFADCSlotMap.find(d->slot) != fFADCSlotMap.end()) {
-	      fTrigTimeShiftMap[d->slot]
-		= fFADCSlotMap[d->slot]->GetTriggerTime() - titime;
-	    }
+      }
+      // Now get the pulse mode data
+      // Pulse area will go into regular SetData, others will use special hit methods
+      Int_t npulses=evdata.GetNumEvents(Decoder::kPulseIntegral, d->crate, d->slot, chan);
+      // Assume that the # of pulses for kPulseTime, kPulsePeak and kPulsePedestal are same;
+      Int_t timeshift = GetTrigTimeShift(evdata, d->slot);
+      for (Int_t ipulse=0;ipulse<npulses;ipulse++) {
+	SetHitPulse(*rawhit, adc, signal,
+		    evdata.GetData(Decoder::kPulseIntegral, d->crate, d->slot, chan, ipulse),
+		    evdata.GetData(Decoder::kPulseTime, d->crate, d->slot, chan, ipulse)+64*timeshift,
+		    evdata.GetData(Decoder::kPulsePedestal, d->crate, d->slot, chan, ipulse),
+		    evdata.GetData(Decoder::kPulsePeak, d->crate, d->slot, chan, ipulse));
+      }
+      // No pulse data, as in raw sample mode.  If enabled with
+      // fadc_emulate, find the pulses in the samples the way the
+      // firmware would.
+      if(fFADCEmulate && npulses == 0 && fHaveFADCInfo && fNPED > 0) {
+	Int_t nsamples=evdata.GetNumEvents(Decoder::kSampleADC, d->crate, d->slot, chan);
+	Int_t threshold = fPSE125->GetThreshold(d->crate, d->slot, chan);
+	if(nsamples > 0 && threshold >= 0) {
+	  fFADCSamples.resize(nsamples);
+	  for (Int_t isamp=0;isamp<nsamples;isamp++) {
+	    fFADCSamples[isamp] = evdata.GetData(Decoder::kSampleADC, d->crate, d->slot, chan, isamp);
 	  }
-	  timeshift = fTrigTimeShiftMap[d->slot];
-	}
-	for (Int_t ipulse=0;ipulse<npulses;ipulse++) {
-	  rawhit->SetDataTimePedestalPeak(signal,
-					  evdata.GetData(Decoder::kPulseIntegral, d->crate, d->slot, chan, ipulse),
-					  evdata.GetData(Decoder::kPulseTime, d->crate, d->slot, chan, ipulse)+64*timeshift,
-					  evdata.GetData(Decoder::kPulsePedestal, d->crate, d->slot, chan, ipulse),
-					  evdata.GetData(Decoder::kPulsePeak, d->crate, d->slot, chan, ipulse));
-	}
-	// Get the reference time for the FADC pulse time
-	if(d->refchan >= 0) {	// Reference time for the slot
-	  Int_t nrefhits = evdata.GetNumEvents(Decoder::kPulseIntegral,
-					       d->crate, d->slot, d->refchan);
-	  Bool_t goodreftime=kFALSE;
-	  Int_t reftime = 0;
-	  timeshift=0;
-	  if(fTISlot>0) {		// Get the trigger time for this module
-	    if(fTrigTimeShiftMap.find(d->slot)
-	       == fTrigTimeShiftMap.end()) { // 
-	      if(fFADCSlotMap.find(d->slot) != fFADCSlotMap.end()) {
-		fTrigTimeShiftMap[d->slot]
-		  = fFADCSlotMap[d->slot]->GetTriggerTime() - titime;
-	      }
-	    }
-	    timeshift = fTrigTimeShiftMap[d->slot];
+	  // MAXPED falls back on the last good pedestal of the channel
+	  Int_t& lastped = fFADCLastPedestal[firedchannels[ifired]];
+	  fFADCEmulator->SetParams(fNSA, fNSB, fNPED, fNP, fNSAT, fMAXPED);
+	  npulses = fFADCEmulator->Analyze(&fFADCSamples[0], nsamples,
+					   threshold, lastped);
+	  if(fFADCEmulator->IsPedestalGood()) {
+	    lastped = fFADCEmulator->GetPedestal();
 	  }
-	  for(Int_t ihit=0; ihit<nrefhits; ihit++) {
-	    reftime = evdata.GetData(Decoder::kPulseTime, d->crate, d->slot, d->refchan, ihit);
-	    reftime += 64*timeshift;
-	    if(reftime >= fADC_RefTimeCut) {
-	      goodreftime=kTRUE;
-	      break;
-	    }
+	  for (Int_t ipulse=0;ipulse<npulses;ipulse++) {
+	    SetHitPulse(*rawhit, adc, signal,
+			fFADCEmulator->GetPulseIntegral(ipulse),
+			fFADCEmulator->GetPulseTime(ipulse)+64*timeshift,
+			fFADCEmulator->GetPedestal(),
+			fFADCEmulator->GetPulsePeak(ipulse));
 	  }
-	  // If RefTimeBest flag set, take the last hit if none of the
-	  // hits make the RefTimeCut
-	  if(goodreftime || (nrefhits>0 && fADC_RefTimeBest)) {
-	    rawhit->SetReference(signal, reftime);
-	  } else if (!suppresswarnings) {
-#ifndef SUPPRESSMISSINGADCREFTIMEMESSAGES
-	    cout << "HitList(event=" << evdata.GetEvNum() << "): refchan " << d->refchan <<
-	      " missing for (" << d->crate << ", " << d->slot <<
-	      ", " << chan << ")" << endl;
-#endif
-	      adcref_miss = kTRUE;
+	}
+      }
+      // Get the reference time for the FADC pulse time
+      if(d->refchan >= 0) {	// Reference time for the slot
+	// If RefTimeBest flag set, take the last hit if none of the
+	// hits make the RefTimeCut
+	Int_t reftime = 0;
+	if(gHcRefTimeCache->GetADCRefTime(evdata, d->crate, d->slot, d->refchan,
+					  fADC_RefTimeCut, fADC_RefTimeBest,
+					  timeshift, reftime)) {
+	  SetHitReference(*rawhit, adc, tdc, signal, reftime);
+	} else if (!suppresswarnings) {
+	  if(gHcDiagnostics->Count(fDiagADCRefMiss)) {
+	    gHcDiagnostics->Keep(fDiagADCRefMiss,
+				 Form("HitList(event=%d): refchan %d missing for (%d, %d, %d)",
+				      evdata.GetEvNum(), d->refchan, d->crate, d->slot, chan));
 	  }
-	} else {
-	  if(d->refindex >=0 && d->refindex < fNRefIndex) {
-	    if(fRefIndexMaps[d->refindex].hashit) {
-	      rawhit->SetReference(signal, fRefIndexMaps[d->refindex].reftime);
-	    } else {
-	      if(!suppresswarnings) {
-#ifndef SUPPRESSMISSINGADCREFTIMEMESSAGES
-		cout << "HitList(event=" << evdata.GetEvNum() << "): refindex " << d->refindex <<
-		  " (" << fRefIndexMaps[d->refindex].crate <<
-		  ", " << fRefIndexMaps[d->refindex].slot <<
-		  ", " << fRefIndexMaps[d->refindex].channel << ")" <<
-		  " missing for (" << d->crate << ", " << d->slot <<
-		  ", " << chan << ")" << endl;
-#endif
-		adcref_miss = kTRUE;
+	  adcref_miss = kTRUE;
+	}
+      } else {
+	if(d->refindex >=0 && d->refindex < fNRefIndex) {
+	  if(fRefIndexMaps[d->refindex].hashit) {
+	    SetHitReference(*rawhit, adc, tdc, signal, fRefIndexMaps[d->refindex].reftime);
+	  } else {
+	    if(!suppresswarnings) {
+	      if(gHcDiagnostics->Count(fDiagADCRefMiss)) {
+		gHcDiagnostics->Keep(fDiagADCRefMiss,
+				     Form("HitList(event=%d): refindex %d (%d, %d, %d) missing for (%d, %d, %d)",
+					  evdata.GetEvNum(), d->refindex,
+					  fRefIndexMaps[d->refindex].crate,
+					  fRefIndexMaps[d->refindex].slot,
+					  fRefIndexMaps[d->refindex].channel,
+					  d->crate, d->slot, chan));
 	      }
+	      adcref_miss = kTRUE;
 	    }
 	  }
 	}
       }
     }
   }
-#if 1
-  if(fTISlot>0) {
-    //    cout << "TI ROC: " << fTICrate << "   TI Time: " << titime << endl;
-    map<Int_t, Int_t>::iterator it;
-    for(it=fTrigTimeShiftMap.begin(); it!=fTrigTimeShiftMap.end(); it++) {
-      if(it->second < -3 || it->second > 3) {
-	cout << "Big ADC Trigger Time Shift, ROC " << fTICrate << endl;
-	cout << it->first << " " << it->second << endl;
-      }
+}
+
+Int_t THcHitList::GetTrigTimeShift(const THaEvData& evdata, Int_t slot)
+{
+  /// FADC trigger time shift (in 4 ns units) of a slot in the TI crate.
+  /// Zero if slip correction is off or the slot holds no FADC.
+  if(fTISlot <= 0) return 0;
+  std::map<Int_t, Decoder::Fadc250Module*>::iterator it = fFADCSlotMap.find(slot);
+  Decoder::Fadc250Module* fadc = (it != fFADCSlotMap.end()) ? it->second : 0;
+  Int_t timeshift = gHcRefTimeCache->GetTrigTimeShift(evdata, fTICrate, fTISlot,
+						      slot, fadc);
+  fTrigTimeShiftMap[slot] = timeshift;
+  return timeshift;
+}
+void THcHitList::SetWantSamples(Bool_t want, Int_t signal)
+{
+  /**
+\brief Declare whether the detector uses FADC samples
+
+Samples of wanted signals are copied into the raw hits while decoding.
+Samples of other signals are copied only if a sample accessor of the
+raw hit is called.  Call after InitHitList.
+
+\param[in] want kTRUE to copy the samples while decoding
+\param[in] signal Signal to set, or -1 for all signals
+  */
+  for(UInt_t isig=0;isig<fWantSamples.size();isig++) {
+    if(signal < 0 || (UInt_t) signal == isig) {
+      fWantSamples[isig] = want;
     }
   }
-#endif    
-  fRawHitList->Sort(fNRawHits);
-
-  fNTDCRef_miss += (tdcref_miss ? 1 : 0);
-  fNADCRef_miss += (adcref_miss ? 1 : 0);
-  return fNRawHits;		// Does anything care what is returned
 }
+
 void THcHitList::CreateMissReportParms(const char *prefix)
 {
   /**
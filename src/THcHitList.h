@@ -2,6 +2,7 @@
 #define ROOT_THcHitList
 
 #include "THcRawHit.h"
+#include "THcRawDataArena.h"
 #include "THaDetMap.h"
 #include "THaEvData.h"
 #include "TClonesArray.h"
@@ -12,6 +13,7 @@
 
 #include <iomanip>
 #include <map>
+#include <vector>
 
 using namespace std;
 
@@ -23,6 +25,7 @@ using namespace std;
 
 //class THaDetMap;
 class THcConfigEvtHandler;
+class THcFADC250Emulator;
 
 class THcHitList {
 
@@ -41,6 +44,8 @@ public:
   void          CreateMissReportParms(const char *prefix);
   void          MissReport(const char *name);
   void          DisableSlipCorrection() {fDisableSlipCorrection = kTRUE;}
+  void          SetWantSamples(Bool_t want=kTRUE, Int_t signal=-1);
+  static void   ResetEventCaches();
 
   UInt_t         fNRawHits;
   Int_t         fNMaxRawHits;
@@ -49,7 +54,10 @@ public:
   Bool_t        fTDC_RefTimeBest;
   Bool_t        fADC_RefTimeBest;
   TClonesArray* fRawHitList; // List of raw hits
+  THcRawDataArena* fRawDataArena; // Samples and multihit times of fRawHitList
   TClass* fRawHitClass;		  // Class of raw hit object to use
+  enum ERawHitKind { kGenericHit, kHodoHit, kShowerHit, kDCHit, kTrigHit };
+  ERawHitKind fRawHitKind;	  // Hit class family, selects FillHits version
 
   THaDetMap*    fdMap;
 
@@ -58,6 +66,7 @@ protected:
   struct RefIndexMap { // Mapping for one reference channel
     Bool_t defined;
     Bool_t hashit;
+    Bool_t multifunction;	// Resolved at first event
     Int_t crate;
     Int_t slot;
     Int_t channel;
@@ -70,15 +79,26 @@ protected:
   Int_t fNRefIndex;
   UInt_t fNSignals;
   THcRawHit::ESignalType *fSignalTypes;
+  std::vector<Bool_t> fWantSamples; // Copy FADC samples while decoding
 
   THcConfigEvtHandler* fPSE125;
   Bool_t fHaveFADCInfo;
   Int_t fNSA;
   Int_t fNSB;
   Int_t fNPED;
+  Int_t fNP;
+  Int_t fNSAT;
+  Int_t fMAXPED;
+  Int_t fFADCEmulate;		     // Emulate pulse analysis for raw sample mode
+  THcFADC250Emulator* fFADCEmulator; // Pulse analysis for raw sample mode
+  std::vector<Int_t> fFADCSamples;   // Samples of the channel being analyzed
+  std::vector<Int_t> fFADCLastPedestal; // Last good emulated pedestal per channel entry
 
   Int_t fNTDCRef_miss;
   Int_t fNADCRef_miss;
+  Int_t fDiagTDCRefMiss;	// gHcDiagnostics message types
+  Int_t fDiagADCRefMiss;
+  Int_t fDiagTrigTimeShift;
 
   Decoder::THaCrateMap* fMap;	/* The Crate map */
   Int_t fTISlot;
@@ -87,6 +107,48 @@ protected:
   std::map<Int_t, Int_t> fTrigTimeShiftMap;
   std::map<Int_t, Decoder::Fadc250Module*> fFADCSlotMap;
 
+  // Dense (plane, counter) -> hit slot index.  Built once in InitHitList
+  // from the detector map.  Slots are numbered in (plane, counter) order,
+  // so hits created in slot order come out already sorted.
+  Int_t GetHitSlot(Int_t plane, Int_t counter) const {
+    return fPlaneSlotOffset[plane] + counter - fPlaneCounterMin[plane];
+  }
+  std::vector<Int_t> fPlaneSlotOffset; // First slot of each plane
+  std::vector<Int_t> fPlaneCounterMin; // Lowest counter of each plane
+  std::vector<Int_t> fSlotPlane;       // Plane of each slot
+  std::vector<Int_t> fSlotCounter;     // Counter of each slot
+  std::vector<Int_t> fSlotHitIndex;    // Hit list index of each slot, -1 if not fired
+
+  // Flattened channel dispatch table.  Everything needed to decode a
+  // channel is resolved once, so the event loop only touches fired channels.
+  // The channels are registered with gHcChannelOwnerMap, which walks the
+  // event data once for all hit lists.
+  struct ChannelEntry {		// Decode info for one mapped channel
+    Int_t crate;
+    Int_t slot;
+    Int_t chan;
+    Int_t plane;
+    Int_t counter;
+    Int_t signal;
+    Int_t signaltype;		// THcRawHit::ESignalType of signal
+    Int_t refchan;
+    Int_t refindex;
+    Int_t hitslot;
+    Bool_t multifunction;	// Resolved at first event
+  };
+  std::vector<ChannelEntry> fChannelEntries;
+  Int_t fChannelOwner;              // Owner number in gHcChannelOwnerMap
+  Bool_t fHaveMultifunction;        // ChannelEntry::multifunction is valid
+
+  std::vector<Int_t> fFiredSlots;    // Slots fired in the current event
+
+  Int_t GetTrigTimeShift(const THaEvData& evdata, Int_t slot);
+  template<class Hit>
+  void FillHits(const THaEvData& evdata, const std::vector<Int_t>& firedchannels,
+		Bool_t suppresswarnings, Bool_t& tdcref_miss, Bool_t& adcref_miss);
+  void BuildHitSlotIndex();
+  void BuildChannelTable();
+
   ClassDef(THcHitList,0);  // List of raw hits sorted by plane, counter
 };
 #endif
@@ -312,10 +312,12 @@ Int_t THcHodoEff::Process( const THaEvData& evdata )
   // Bool_t goodTdcBothSides[fNPlanes];
   // Bool_t goodTdcOneSide[fNPlanes];
 
+  // The hodoscope already projected the tracks to its planes, at the
+  // middle of the plane (fPosZ) too.
   for(Int_t ip=0;ip<fNPlanes;ip++) {
+    hitPos[ip] = fHod->GetTrackProjection(trackIndex,ip).trnsMid;
     // Should really have plane object self identify as X or Y
     if(ip%2 == 0) {		// X Plane
-      hitPos[ip] = theTrack->GetX() + theTrack->GetTheta()*fPosZ[ip];
       hitCounter[ip] = TMath::Max(
 			TMath::Min(
 			 TMath::Nint((hitPos[ip]-fCenterFirst[ip])/
@@ -323,7 +325,6 @@ Int_t THcHodoEff::Process( const THaEvData& evdata )
       hitDistance[ip] =  hitPos[ip] - (fSpacing[ip]*(hitCounter[ip]-1) +
 				       fCenterFirst[ip]);
     } else {			// Y Plane
-      hitPos[ip] = theTrack->GetY() + theTrack->GetPhi()*fPosZ[ip];
       hitCounter[ip] = TMath::Max(
 		        TMath::Min(
 		         TMath::Nint((fCenterFirst[ip]-hitPos[ip])/
@@ -92,8 +92,6 @@ void THcHodoscope::Setup(const char* name, const char* description)
   TString temp(prefix[0]);
   fSHMS=kFALSE;
   if (temp == "p" ) fSHMS=kTRUE;
-  TString histname=temp+"_timehist";
-  hTime = new TH1F(histname,"",400,0,200);
   // cout << " fSHMS = " << fSHMS << endl;
   string planenamelist;
   DBRequest listextra[]={
@@ -181,6 +179,10 @@ THaAnalysisObject::EStatus THcHodoscope::Init( const TDatime& date )
     if((status = fPlanes[ip]->Init( date ))) {
       return fStatus=status;
     }
+    // Only the sample integral modes read every FADC sample
+    if(fPlanes[ip]->UsesADCSamples()) {
+      SetWantSamples();
+    }
   }
 
   fNScinHits     = new Int_t [fNPlanes];
@@ -295,6 +297,14 @@ Int_t THcHodoscope::ReadDatabase( const TDatime& date )
   fHodoNeg_c2=new Double_t [fMaxHodoScin];
   fHodoSigmaPos=new Double_t [fMaxHodoScin];
   fHodoSigmaNeg=new Double_t [fMaxHodoScin];
+  fHodoPosTwRef=new Double_t [fMaxHodoScin];
+  fHodoNegTwRef=new Double_t [fMaxHodoScin];
+  fHodoTofPosSigma=new Double_t [fMaxHodoScin];
+  fHodoTofNegSigma=new Double_t [fMaxHodoScin];
+  fHodoTofSigma=new Double_t [fMaxHodoScin];
+  fHodoTofWeight=new Double_t [fMaxHodoScin];
+  fHodoTofPosWeight=new Double_t [fMaxHodoScin];
+  fHodoTofNegWeight=new Double_t [fMaxHodoScin];
 
   fNHodoscopes = 2;
   fxLoScin = new Int_t [fNHodoscopes];
@@ -486,6 +496,25 @@ Int_t THcHodoscope::ReadDatabase( const TDatime& date )
        }
     
      gHcParms->LoadParmValues((DBRequest*)&list4,prefix);
+
+  // Per paddle terms of the time walk correction and of the start time
+  // and beta fits that do not depend on the event
+  for (UInt_t i=0; i<fMaxHodoScin; i++) {
+    fHodoPosTwRef[i] = 1./pow(200./fTdc_Thrs, fHodoPos_c2[i]);
+    fHodoNegTwRef[i] = 1./pow(200./fTdc_Thrs, fHodoNeg_c2[i]);
+    if (fTofUsingInvAdc) {
+      fHodoTofPosSigma[i] = fHodoPosSigma[i];
+      fHodoTofNegSigma[i] = fHodoNegSigma[i];
+    } else {
+      fHodoTofPosSigma[i] = fHodoSigmaPos[i];
+      fHodoTofNegSigma[i] = fHodoSigmaNeg[i];
+    }
+    fHodoTofSigma[i] = TMath::Sqrt(fHodoTofPosSigma[i]*fHodoTofPosSigma[i] +
+				   fHodoTofNegSigma[i]*fHodoTofNegSigma[i])/2.;
+    fHodoTofWeight[i] = 1./(fHodoTofSigma[i]*fHodoTofSigma[i]);
+    fHodoTofPosWeight[i] = 1./(fHodoTofPosSigma[i]*fHodoTofPosSigma[i]);
+    fHodoTofNegWeight[i] = 1./(fHodoTofNegSigma[i]*fHodoTofNegSigma[i]);
+  }
   
   if (fDebug >=1) {
     cout <<"******* Testing Hodoscope Parameter Reading ***\n";
@@ -630,6 +659,14 @@ void THcHodoscope::DeleteArrays()
   delete [] fHodoNeg_c2;                 fHodoNeg_c2 = NULL;
   delete [] fHodoSigmaPos;               fHodoSigmaPos = NULL;
   delete [] fHodoSigmaNeg;               fHodoSigmaNeg = NULL;
+  delete [] fHodoPosTwRef;               fHodoPosTwRef = NULL;
+  delete [] fHodoNegTwRef;               fHodoNegTwRef = NULL;
+  delete [] fHodoTofPosSigma;            fHodoTofPosSigma = NULL;
+  delete [] fHodoTofNegSigma;            fHodoTofNegSigma = NULL;
+  delete [] fHodoTofSigma;               fHodoTofSigma = NULL;
+  delete [] fHodoTofWeight;              fHodoTofWeight = NULL;
+  delete [] fHodoTofPosWeight;           fHodoTofPosWeight = NULL;
+  delete [] fHodoTofNegWeight;           fHodoTofNegWeight = NULL;
 }
 
 //_____________________________________________________________________________
@@ -664,6 +701,7 @@ void THcHodoscope::Clear( Option_t* opt )
     }
   }
   fdEdX.clear();
+  fdEdXOffset.clear();
   fNScinHit.clear();
   fNClust.clear();
   fClustSize.clear();
@@ -671,6 +709,8 @@ void THcHodoscope::Clear( Option_t* opt )
   fThreeScin.clear();
   fGoodScinHitsX.clear();
   fGoodFlags.clear();
+  fGoodFlagsOffset.clear();
+  fTrackProjection.clear();
 }
 
 //_____________________________________________________________________________
@@ -767,7 +807,7 @@ void THcHodoscope::EstimateFocalPlaneTime()
    */
   Int_t ihit=0;
   Int_t nscinhits=0;		// Total # hits with at least one good tdc
-  hTime->Reset();
+  fTimeHist.Reset();
   //
   for(Int_t ip=0;ip<fNPlanes;ip++) {
     Int_t nphits=fPlanes[ip]->GetNScinHits();
@@ -778,8 +818,8 @@ void THcHodoscope::EstimateFocalPlaneTime()
       if(hit->GetHasCorrectedTimes()) {
 	Double_t postime=hit->GetPosTOFCorrectedTime();
 	Double_t negtime=hit->GetNegTOFCorrectedTime();
-	hTime->Fill(postime);
-	hTime->Fill(negtime);
+	fTimeHist.Fill(postime);
+	fTimeHist.Fill(negtime);
       }
     }
   }
@@ -792,10 +832,10 @@ void THcHodoscope::EstimateFocalPlaneTime()
   Double_t Plane_fptime_sum=0.0;
   Bool_t goodplanetime[fNPlanes];
   Bool_t twogoodtimes[nscinhits];
-  Double_t tmin = 0.5*hTime->GetMaximumBin();
+  Double_t tmin = 0.5*fTimeHist.GetMaximumBin();
   fTimeHist_Peak=  tmin;
-  fTimeHist_Sigma=  hTime->GetRMS();
-  fTimeHist_Hits=  hTime->Integral();
+  fTimeHist_Sigma=  fTimeHist.GetRMS();
+  fTimeHist_Hits=  fTimeHist.Integral();
   for(Int_t ip=0;ip<fNumPlanesBetaCalc;ip++) {
     goodplanetime[ip] = kFALSE;
     Int_t nphits=fPlanes[ip]->GetNScinHits();
@@ -849,7 +889,7 @@ void THcHodoscope::EstimateFocalPlaneTime()
   }
     //
    //
-  hTime->Reset();
+  fTimeHist.Reset();
   //
   if((goodplanetime[0]||goodplanetime[1]) &&(goodplanetime[2]||goodplanetime[3])) {
 
@@ -869,18 +909,7 @@ void THcHodoscope::EstimateFocalPlaneTime()
 
 	if(twogoodtimes[ihhit]){
 
-	  Double_t sigma = 0.0;
-	  if(fTofUsingInvAdc)
-	    {
-	      sigma = 0.5 * ( TMath::Sqrt( TMath::Power( fHodoPosSigma[GetScinIndex(ip,index)],2) +
-					   TMath::Power( fHodoNegSigma[GetScinIndex(ip,index)],2) ) );
-	    }
-	  else{
-	    sigma = 0.5 * ( TMath::Sqrt( TMath::Power( fHodoSigmaPos[GetScinIndex(ip,index)],2) +
-					 TMath::Power( fHodoSigmaNeg[GetScinIndex(ip,index)],2) ) );
-	  }
-
-	  Double_t scinWeight = 1 / TMath::Power(sigma,2);
+	  Double_t scinWeight = fHodoTofWeight[GetScinIndex(ip,index)];
 	  Double_t zPosition = fPlanes[ip]->GetZpos() + (index%2)*fPlanes[ip]->GetDzpos();
  	  //	  cout << "hit = " << ihhit + 1 << "   zpos = " << zPosition << "   sigma = " << sigma << endl;
 	  //cout << "fHodoSigma+ = " << fHodoSigmaPos[GetScinIndex(ip,index)] << endl;
@@ -917,18 +946,8 @@ void THcHodoscope::EstimateFocalPlaneTime()
 	    Double_t zPosition = fPlanes[ip]->GetZpos() + (index%2)*fPlanes[ip]->GetDzpos();
 	    Double_t timeDif = ( ((THcHodoHit*)hodoHits->At(i))->GetScinCorrectedTime() - t0 );
 	   
-	    Double_t sigma = 0.0;
-	    if(fTofUsingInvAdc){
-	      sigma = 0.5 * ( TMath::Sqrt( TMath::Power( fHodoPosSigma[GetScinIndex(ip,index)],2) +
-					   TMath::Power( fHodoNegSigma[GetScinIndex(ip,index)],2) ) );
-	    }
-	    else {
-	      sigma = 0.5 * ( TMath::Sqrt( TMath::Power( fHodoSigmaPos[GetScinIndex(ip,index)],2) +
-					   TMath::Power( fHodoSigmaNeg[GetScinIndex(ip,index)],2) ) );
-	    }
-
 	    fBetaNoTrkChiSq += ( ( zPosition / fBetaNoTrk - timeDif ) *
-				 ( zPosition / fBetaNoTrk - timeDif ) ) / ( sigma * sigma );
+				 ( zPosition / fBetaNoTrk - timeDif ) ) * fHodoTofWeight[GetScinIndex(ip,index)];
 
 
 	  } // condition for good scin time
@@ -968,6 +987,47 @@ Double_t THcHodoscope::TimeWalkCorrection(const Int_t& paddle,
 }
 
 
+//_____________________________________________________________________________
+void THcHodoscope::ProjectTracks( TClonesArray& tracks )
+{
+  /**
+    Project each track to each plane and find the paddles it goes
+    through, once per event.  The result is kept in fTrackProjection.
+  */
+  Int_t ntracks = tracks.GetLast()+1;
+  fTrackProjection.resize(ntracks*fNPlanes);
+  for (Int_t itrack = 0; itrack < ntracks; itrack++) {
+    THaTrack* theTrack = dynamic_cast<THaTrack*>( tracks.At(itrack) );
+    if (!theTrack) continue;
+    for (Int_t ip = 0; ip < fNPlanes; ip++) {
+      TrackProjection& proj = fTrackProjection[itrack*fNPlanes+ip];
+      Double_t zPos = fPlanes[ip]->GetZpos();
+      Double_t dzPos = fPlanes[ip]->GetDzpos();
+      Double_t halfwidth = fPlanes[ip]->GetSize() * 0.5 + fPlanes[ip]->GetHodoSlop();
+      for (Int_t parity = 0; parity < 2; parity++) {
+	Double_t zposition = zPos + parity*dzPos;
+	Double_t xHitCoord = theTrack->GetX() + theTrack->GetTheta() * zposition;
+	Double_t yHitCoord = theTrack->GetY() + theTrack->GetPhi() * zposition;
+	if (ip%2 == 0) {	// x plane
+	  proj.trns[parity] = xHitCoord;
+	  proj.lng[parity] = yHitCoord;
+	} else {		// y plane
+	  proj.trns[parity] = yHitCoord;
+	  proj.lng[parity] = xHitCoord;
+	}
+	fPlanes[ip]->FindPaddleRange(proj.trns[parity], halfwidth,
+				     proj.first[parity], proj.last[parity]);
+      }
+      Double_t zmid = zPos + 0.5*dzPos;
+      if (ip%2 == 0) {
+	proj.trnsMid = theTrack->GetX() + theTrack->GetTheta()*zmid;
+      } else {
+	proj.trnsMid = theTrack->GetY() + theTrack->GetPhi()*zmid;
+      }
+    }
+  }
+}
+
 //_____________________________________________________________________________
 Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
 {
@@ -980,14 +1040,12 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
 
   if (ntracks > 0 ) {
 
+    ProjectTracks(tracks);
+
     // **MAIN LOOP: Loop over all tracks and get corrected time, tof, beta...
-    vector<Double_t> nPmtHit(ntracks);
-    vector<Double_t> timeAtFP(ntracks);
-    fdEdX.reserve(ntracks);
-    fGoodFlags.reserve(ntracks);
+    fNPmtHit.assign(ntracks, 0.0);
+    fTimeAtFP.assign(ntracks, 0.0);
     for ( Int_t itrack = 0; itrack < ntracks; itrack++ ) { // Line 133
-      nPmtHit[itrack]=0;
-      timeAtFP[itrack]=0;
 
       THaTrack* theTrack = dynamic_cast<THaTrack*>( tracks.At(itrack) );
       if (!theTrack) return -1;
@@ -998,20 +1056,11 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
 	fNPlaneTime[ip] = 0;
 	fSumPlaneTime[ip] = 0.;
       }
-      std::vector<Double_t> dedx_temp;
-      std::vector<std::vector<GoodFlags> > goodflagstmp1;
-      goodflagstmp1.reserve(fNumPlanesBetaCalc);
-#if __cplusplus >= 201103L
-      fdEdX.push_back(std::move(dedx_temp)); // Create array of dedx per hit
-      fGoodFlags.push_back(std::move(goodflagstmp1));
-#else
-      fdEdX.push_back(dedx_temp); // Create array of dedx per hit
-      fGoodFlags.push_back(goodflagstmp1);
-#endif
+      fdEdXOffset.push_back(fdEdX.size()); // dedx per hit of this track
       Int_t nFPTime = 0;
       Double_t betaChiSq = -3;
       Double_t beta = 0;
-      //      timeAtFP[itrack] = 0.;
+      //      fTimeAtFP[itrack] = 0.;
       Double_t sumFPTime = 0.; // Line 138
       fNScinHit.push_back(0);
 
@@ -1030,25 +1079,22 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
 
       // Loop over scintillator planes.
       // In ENGINE, its loop over good scintillator hits.
-      hTime->Reset();
+      fTimeHist.Reset();
       fTOFCalc.clear();   // SAW - Can we
       fTOFPInfo.clear();  // SAW - combine these two?
       Int_t ihhit = 0;		// Hit # overall
 
       for(Int_t ip = 0; ip < fNumPlanesBetaCalc; ip++ ) {
 
-	std::vector<GoodFlags> goodflagstmp2;
-	goodflagstmp2.reserve(fNScinHits[ip]);
-#if __cplusplus >= 201103L
-	fGoodFlags[itrack].push_back(std::move(goodflagstmp2));
-#else
-	fGoodFlags[itrack].push_back(goodflagstmp2);
-#endif
 	fNScinHits[ip] = fPlanes[ip]->GetNScinHits();
+	// Flags of this plane's hits, all kFALSE
+	fGoodFlagsOffset.push_back(fGoodFlags.size());
+	fGoodFlags.resize(fGoodFlags.size()+fNScinHits[ip]);
 	TClonesArray* hodoHits = fPlanes[ip]->GetHits();
 
 	Double_t zPos = fPlanes[ip]->GetZpos();
 	Double_t dzPos = fPlanes[ip]->GetDzpos();
+	const TrackProjection& proj = GetTrackProjection(itrack, ip);
 
 	// first loop over hits with in a single plane
 	for (Int_t iphit = 0; iphit < fNScinHits[ip]; iphit++ ){
@@ -1069,33 +1115,22 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
 	  fTOFPInfo[ihhit].onTrack = kFALSE;
 
 	  Int_t paddle = hit->GetPaddleNumber()-1;
-	  Double_t zposition = zPos + (paddle%2)*dzPos;
-
-	  Double_t xHitCoord = theTrack->GetX() + theTrack->GetTheta() *
-	    ( zposition ); // Line 183
-
-	  Double_t yHitCoord = theTrack->GetY() + theTrack->GetPhi() *
-	    ( zposition ); // Line 184
+	  Int_t parity = paddle%2;
+	  Double_t zposition = zPos + parity*dzPos;
 
-	  Double_t scinTrnsCoord, scinLongCoord;
-	  if ( ( ip == 0 ) || ( ip == 2 ) ){ // !x plane. Line 185
-	    scinTrnsCoord = xHitCoord;
-	    scinLongCoord = yHitCoord;
-	  } else if ( ( ip == 1 ) || ( ip == 3 ) ){ // !y plane. Line 188
-	    scinTrnsCoord = yHitCoord;
-	    scinLongCoord = xHitCoord;
-	  } else { return -1; } // Line 195
+	  // Track position at the paddle, from ProjectTracks
+	  Double_t scinTrnsCoord = proj.trns[parity];
+	  Double_t scinLongCoord = proj.lng[parity];
 
 	  fTOFPInfo[ihhit].scinTrnsCoord = scinTrnsCoord;
 	  fTOFPInfo[ihhit].scinLongCoord = scinLongCoord;
 
-	  Double_t scinCenter = fPlanes[ip]->GetPosCenter(paddle) + fPlanes[ip]->GetPosOffset();
-
 	  // Index to access the 2d arrays of paddle/scintillator properties
 	  Int_t fPIndex = GetScinIndex(ip,paddle);
-          
-	  if ( TMath::Abs( scinCenter - scinTrnsCoord ) <
-	       ( fPlanes[ip]->GetSize() * 0.5 + fPlanes[ip]->GetHodoSlop() ) ){ // Line 293
+
+	  // Paddle center within half a paddle plus the slop of the track
+	  if ( fPlanes[ip]->IsPaddleInRange(paddle, proj.first[parity],
+					    proj.last[parity]) ){ // Line 293
 
 	    fTOFPInfo[ihhit].onTrack = kTRUE;
 	    Double_t zcor = zposition/(29.979*fBetaNominal)*
@@ -1124,14 +1159,14 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
 	        //Double_t tw_corr_pos = fHodoPos_c1[fPIndex]/pow(adcamp_pos/fTdc_Thrs,fHodoPos_c2[fPIndex]) -  fHodoPos_c1[fPIndex]/pow(200./fTdc_Thrs, fHodoPos_c2[fPIndex]);
 		Double_t tw_corr_pos=0.;
 		pathp=scinLongCoord;
-		if (adcamp_pos>0) tw_corr_pos = 1./pow(adcamp_pos/fTdc_Thrs,fHodoPos_c2[fPIndex]) -  1./pow(200./fTdc_Thrs, fHodoPos_c2[fPIndex]);            
+		if (adcamp_pos>0) tw_corr_pos = TimeWalkPower(adcamp_pos/fTdc_Thrs,fHodoPos_c2[fPIndex]) - fHodoPosTwRef[fPIndex];
 		timep += -tw_corr_pos + fHodo_LCoeff[fPIndex]+ pathp/fHodoVelFit[fPIndex];
 	      }
 	      fTOFPInfo[ihhit].scin_pos_time = timep;
  	      timep -= zcor;
 	      fTOFPInfo[ihhit].time_pos = timep;
 
-              hTime->Fill(timep);
+              fTimeHist.Fill(timep);
 	    }
 	    Double_t tdc_neg = hit->GetNegTDC();
 	    if(tdc_neg >=fScinTdcMin && tdc_neg <= fScinTdcMax ) {
@@ -1148,14 +1183,14 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
 	      } else {
 		pathn=scinLongCoord ;
 		Double_t tw_corr_neg =0 ;
-		if (adcamp_neg >0) tw_corr_neg= 1./pow(adcamp_neg/fTdc_Thrs,fHodoNeg_c2[fPIndex]) -  1./pow(200./fTdc_Thrs, fHodoNeg_c2[fPIndex]);              
+		if (adcamp_neg >0) tw_corr_neg= TimeWalkPower(adcamp_neg/fTdc_Thrs,fHodoNeg_c2[fPIndex]) - fHodoNegTwRef[fPIndex];
 		timen += -tw_corr_neg- 2*fHodoCableFit[fPIndex] + fHodo_LCoeff[fPIndex]- pathn/fHodoVelFit[fPIndex];
 
 	      }
 	      fTOFPInfo[ihhit].scin_neg_time = timen;
 	      timen -=  zcor;
 	      fTOFPInfo[ihhit].time_neg = timen;
-              hTime->Fill(timen);
+              fTimeHist.Fill(timen);
 	    }
 	  } // condition for cenetr on a paddle
 	  ihhit++;
@@ -1168,8 +1203,8 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
       Int_t nhits=ihhit;
 
 
-      if(0.5*hTime->GetMaximumBin() > 0) {
-	Double_t tmin = 0.5*hTime->GetMaximumBin();
+      if(0.5*fTimeHist.GetMaximumBin() > 0) {
+	Double_t tmin = 0.5*fTimeHist.GetMaximumBin();
 	
 	for(Int_t ih = 0; ih < nhits; ih++) { // loop over all scintillator hits
 	  if ( ( fTOFPInfo[ih].time_pos > (tmin-fTofTolerance) ) && ( fTOFPInfo[ih].time_pos < ( tmin + fTofTolerance ) ) ) {
@@ -1185,7 +1220,6 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
       // ---------------------- Second loop over scint. hits in a plane -----------------------------
       //---------------------------------------------------------------------------------------------
  
-      fdEdX[itrack].reserve(nhits);
       fTOFCalc.reserve(nhits);
       for(Int_t ih=0; ih < nhits; ih++) {
 	THcHodoHit *hit = fTOFPInfo[ih].hit;
@@ -1193,13 +1227,8 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
 	Int_t ip = fTOFPInfo[ih].planeIndex;
 	//         fDumpOut << " looping over hits = " << ih << " plane = " << ip+1 << endl;
 	// Flags are used by THcHodoEff
-	fGoodFlags[itrack][ip].reserve(nhits);
-	fGoodFlags[itrack][ip].push_back(GoodFlags());
-	assert( iphit >= 0 && (size_t)iphit < fGoodFlags[itrack][ip].size() );
-	fGoodFlags[itrack][ip][iphit].onTrack = kFALSE;
-	fGoodFlags[itrack][ip][iphit].goodScinTime = kFALSE;
-	fGoodFlags[itrack][ip][iphit].goodTdcNeg = kFALSE;
-	fGoodFlags[itrack][ip][iphit].goodTdcPos = kFALSE;
+	assert( iphit >= 0 && iphit < fNScinHits[ip] );
+	GoodFlags& flags = GetGoodFlags(itrack,ip,iphit);
 
 	fTOFCalc.push_back(TOFCalc());
 	// Do we set back to false for each track, or just once per event?
@@ -1221,14 +1250,14 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
 	Int_t fPIndex = GetScinIndex(ip,paddle);
 
 	if (fTOFPInfo[ih].onTrack) {
-	  fGoodFlags[itrack][ip][iphit].onTrack = kTRUE;
+	  flags.onTrack = kTRUE;
 	  if ( fTOFPInfo[ih].keep_pos ) { // 301
 	    fTOFCalc[ih].good_tdc_pos = kTRUE;
-	    fGoodFlags[itrack][ip][iphit].goodTdcPos = kTRUE;
+	    flags.goodTdcPos = kTRUE;
 	  }
 	  if ( fTOFPInfo[ih].keep_neg ) { //
 	    fTOFCalc[ih].good_tdc_neg = kTRUE;
-	    fGoodFlags[itrack][ip][iphit].goodTdcNeg = kTRUE;
+	    flags.goodTdcNeg = kTRUE;
 	  }
 	  // ** Calculate ave time for scin and error.
 	  if ( fTOFCalc[ih].good_tdc_pos ){
@@ -1238,43 +1267,29 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
 	      fTOFCalc[ih].scin_time_fp  = ( fTOFPInfo[ih].time_pos +
 					     fTOFPInfo[ih].time_neg ) / 2.;
 	      
-	      if (fTofUsingInvAdc){
-		fTOFCalc[ih].scin_sigma = TMath::Sqrt( fHodoPosSigma[fPIndex] * fHodoPosSigma[fPIndex] +
-						       fHodoNegSigma[fPIndex] * fHodoNegSigma[fPIndex] )/2.;
-	      }
-	      else {
-		fTOFCalc[ih].scin_sigma = TMath::Sqrt( fHodoSigmaPos[fPIndex] * fHodoSigmaPos[fPIndex] +
-						       fHodoSigmaNeg[fPIndex] * fHodoSigmaNeg[fPIndex] )/2.;
-	      }
+	      fTOFCalc[ih].scin_sigma = fHodoTofSigma[fPIndex];
+	      fTOFCalc[ih].scin_weight = fHodoTofWeight[fPIndex];
 
 	      fTOFCalc[ih].good_scin_time = kTRUE;
-	      fGoodFlags[itrack][ip][iphit].goodScinTime = kTRUE;
+	      flags.goodScinTime = kTRUE;
 	    } else{
 	      fTOFCalc[ih].scin_time = fTOFPInfo[ih].scin_pos_time;
 	      fTOFCalc[ih].scin_time_fp = fTOFPInfo[ih].time_pos;
 	      
-	      if (fTofUsingInvAdc){
-		fTOFCalc[ih].scin_sigma = fHodoPosSigma[fPIndex];
-	      }
-	      else{
-		fTOFCalc[ih].scin_sigma = fHodoSigmaPos[fPIndex];
-	      }
+	      fTOFCalc[ih].scin_sigma = fHodoTofPosSigma[fPIndex];
+	      fTOFCalc[ih].scin_weight = fHodoTofPosWeight[fPIndex];
 	      
 	      fTOFCalc[ih].good_scin_time = kTRUE;
-	      fGoodFlags[itrack][ip][iphit].goodScinTime = kTRUE;
+	      flags.goodScinTime = kTRUE;
 	    }
 	  } else {
 	    if ( fTOFCalc[ih].good_tdc_neg ){
 	      fTOFCalc[ih].scin_time = fTOFPInfo[ih].scin_neg_time;
 	      fTOFCalc[ih].scin_time_fp = fTOFPInfo[ih].time_neg;
-	      if (fTofUsingInvAdc){
-		fTOFCalc[ih].scin_sigma = fHodoNegSigma[fPIndex];
-	      }
-	      else{
-		fTOFCalc[ih].scin_sigma = fHodoSigmaNeg[fPIndex];
-	      }
+	      fTOFCalc[ih].scin_sigma = fHodoTofNegSigma[fPIndex];
+	      fTOFCalc[ih].scin_weight = fHodoTofNegWeight[fPIndex];
 	      fTOFCalc[ih].good_scin_time = kTRUE;
-	      fGoodFlags[itrack][ip][iphit].goodScinTime = kTRUE;
+	      flags.goodScinTime = kTRUE;
 	    }
 	  } // In h_tof.f this includes the following if condition for time at focal plane
 	    // // because it is written in FORTRAN code
@@ -1296,29 +1311,29 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
 	    fNScinHit[itrack] ++;
 
 	    if ( ( fTOFCalc[ih].good_tdc_pos ) && ( fTOFCalc[ih].good_tdc_neg ) ){
-	      nPmtHit[itrack] = nPmtHit[itrack] + 2;
+	      fNPmtHit[itrack] = fNPmtHit[itrack] + 2;
 	    } else {
-	      nPmtHit[itrack] = nPmtHit[itrack] + 1;
+	      fNPmtHit[itrack] = fNPmtHit[itrack] + 1;
 	    }
 
-	    fdEdX[itrack].push_back(0.0);
-	    assert( fNScinHit[itrack] > 0 && (size_t)fNScinHit[itrack] < fdEdX[itrack].size()+1 );
+	    fdEdX.push_back(0.0);
+	    Double_t& dedx = fdEdX[fdEdXOffset[itrack]+fNScinHit[itrack]-1];
 
 	    // --------------------------------------------------------------------------------------------
 	    if ( fTOFCalc[ih].good_tdc_pos ){
 	      if ( fTOFCalc[ih].good_tdc_neg ){
-		fdEdX[itrack][fNScinHit[itrack]-1]=
+		dedx=
 		  TMath::Sqrt( TMath::Max( 0., hit->GetPosADC() * hit->GetNegADC() ) );
 	      } else{
-		fdEdX[itrack][fNScinHit[itrack]-1]=
+		dedx=
 		  TMath::Max( 0., hit->GetPosADC() );
 	      }
 	    } else{
 	      if ( fTOFCalc[ih].good_tdc_neg ){
-		fdEdX[itrack][fNScinHit[itrack]-1]=
+		dedx=
 		  TMath::Max( 0., hit->GetNegADC() );
 	      } else{
-		fdEdX[itrack][fNScinHit[itrack]-1]=0.0;
+		dedx=0.0;
 	      }
 	    }
 	    // --------------------------------------------------------------------------------------------
@@ -1330,7 +1345,7 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
 	  // ** See if there are any good time measurements in the plane.
 	if ( fTOFCalc[ih].good_scin_time ){
 	  fGoodPlaneTime[ip] = kTRUE;
-	  fTOFCalc[ih].dedx = fdEdX[itrack][fNScinHit[itrack]-1];
+	  fTOFCalc[ih].dedx = fdEdX[fdEdXOffset[itrack]+fNScinHit[itrack]-1];
 	} else {
 	  fTOFCalc[ih].dedx = 0.0;
 	}
@@ -1364,7 +1379,7 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
 
 	  if ( fTOFCalc[ih].good_scin_time ) {
 
-	    Double_t scinWeight = 1 / ( fTOFCalc[ih].scin_sigma * fTOFCalc[ih].scin_sigma );
+	    Double_t scinWeight = fTOFCalc[ih].scin_weight;
 	    Double_t zPosition = ( fPlanes[ip]->GetZpos()
 				   +( fTOFCalc[ih].hit_paddle % 2 ) *
 				   fPlanes[ip]->GetDzpos() );
@@ -1396,8 +1411,8 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
 				     fPlanes[ip]->GetDzpos() );
 	      Double_t timeDif = ( fTOFCalc[ih].scin_time - t0 );
 	      betaChiSq += ( ( zPosition / beta - timeDif ) *
-			     ( zPosition / beta - timeDif ) )  /
-		( fTOFCalc[ih].scin_sigma * fTOFCalc[ih].scin_sigma );
+			     ( zPosition / beta - timeDif ) )  *
+		fTOFCalc[ih].scin_weight;
 
 	    } // condition for good scin time
 	  } // loop over hits
@@ -1419,7 +1434,7 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
       }
 
       if ( nFPTime != 0 ){
-      	timeAtFP[itrack] = ( sumFPTime / nFPTime );
+      	fTimeAtFP[itrack] = ( sumFPTime / nFPTime );
       }
       //
       // ---------------------------------------------------------------------------
@@ -1449,8 +1464,8 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
       theTrack->SetFPTime(fptime);
       theTrack->SetBeta(beta);
       theTrack->SetBetaChi2( betaChiSq );
-      theTrack->SetNPMT(nPmtHit[itrack]);
-      theTrack->SetFPTime( timeAtFP[itrack]);
+      theTrack->SetNPMT(fNPmtHit[itrack]);
+      theTrack->SetFPTime( fTimeAtFP[itrack]);
 
 
     } // Main loop over tracks ends here.
@@ -1830,7 +1845,7 @@ Int_t THcHodoscope::FineProcess( TClonesArray&  tracks  )
 	    num_good_pad++; 
 	  } 
 	  ih++;
-	  //	  cout << ip << " " << iphit << " " <<  fGoodFlags[itrk][ip][iphit].goodScinTime << " " <<   fGoodFlags[itrk][ip][iphit].goodTdcPos << " " << fGoodFlags[itrk][ip][iphit].goodTdcNeg << endl;
+	  //	  cout << ip << " " << iphit << " " <<  GetGoodFlags(itrk,ip,iphit).goodScinTime << " " <<   GetGoodFlags(itrk,ip,iphit).goodTdcPos << " " << GetGoodFlags(itrk,ip,iphit).goodTdcNeg << endl;
 	}
 	hitDistance=kBig;
 	if (num_good_pad !=0 ) {
@@ -10,7 +10,7 @@
 #include <vector>
 
 #include "TClonesArray.h"
-#include "TH1F.h"
+#include "THcTimePeakFinder.h"
 #include "THaNonTrackingDetector.h"
 #include "THcHitList.h"
 #include "THcHodoHit.h"
@@ -94,6 +94,14 @@ public:
   Double_t GetHodoPos_c2(Int_t iii) const {return fHodoPos_c2[iii];}
   Double_t GetHodoNeg_c2(Int_t iii) const {return fHodoNeg_c2[iii];}
   Double_t GetTDCThrs() const {return fTdc_Thrs;}
+  Double_t GetHodoPosTwRef(Int_t iii) const {return fHodoPosTwRef[iii];}
+  Double_t GetHodoNegTwRef(Int_t iii) const {return fHodoNegTwRef[iii];}
+
+  // Time walk term 1/x^c2.  exp and log are much faster than pow and
+  // agree with it to a few units in the last place.
+  static Double_t TimeWalkPower(Double_t x, Double_t c2) {
+    return x > 0 ? TMath::Exp(-c2*TMath::Log(x)) : 1./TMath::Power(x,c2);
+  }
 
   Double_t GetStartTimeCenter() const {return fStartTimeCenter;}
   Double_t GetStartTimeSlop() const {return fStartTimeSlop;}
@@ -123,15 +131,28 @@ public:
   Bool_t GetFlags(Int_t itrack, Int_t iplane, Int_t ihit,
 		  Bool_t& onTrack, Bool_t& goodScinTime,
 		  Bool_t& goodTdcNeg, Bool_t& goodTdcPos) const {
-    onTrack = fGoodFlags[itrack][iplane][ihit].onTrack;
-    goodScinTime = fGoodFlags[itrack][iplane][ihit].goodScinTime;
-    goodTdcNeg = fGoodFlags[itrack][iplane][ihit].goodTdcNeg;
-    goodTdcPos = fGoodFlags[itrack][iplane][ihit].goodTdcPos;
+    const GoodFlags& flags = GetGoodFlags(itrack,iplane,ihit);
+    onTrack = flags.onTrack;
+    goodScinTime = flags.goodScinTime;
+    goodTdcNeg = flags.goodTdcNeg;
+    goodTdcPos = flags.goodTdcPos;
     return(kTRUE);
   }
 
   const TClonesArray* GetTrackHits() const { return fTrackProj; }
 
+  // A track projected to a plane, at the z of the even (0) and odd (1)
+  // paddles.  Made by CoarseProcess, also used by THcHodoEff.
+  struct TrackProjection {
+    Double_t trns[2];		// Coordinate across the paddles
+    Double_t lng[2];		// Coordinate along the paddles
+    Int_t first[2];		// Paddles within half a paddle plus the slop,
+    Int_t last[2];		// see THcScintillatorPlane::FindPaddleRange
+    Double_t trnsMid;		// Across the paddles, halfway between the two z
+  };
+  const TrackProjection& GetTrackProjection(Int_t itrack, Int_t iplane) const
+  { return fTrackProjection[itrack*fNPlanes+iplane]; }
+
   friend class THaScCalib;
 
   THcHodoscope();  // for ROOT I/O
@@ -146,7 +167,7 @@ protected:
 
   Int_t fNHits;
 
-  TH1F *hTime;
+  THcTimePeakFinder fTimeHist;	// Paddle times, 0.5 ns bins from 0 to 200 ns
   // Calibration
 
   // Per-event data
@@ -214,6 +235,15 @@ protected:
   Double_t  fTdc_Thrs;  
   Double_t* fHodoSigmaPos;
   Double_t* fHodoSigmaNeg;
+  // Computed from the above in ReadDatabase
+  Double_t* fHodoPosTwRef;	// Time walk term at the reference amplitude 200
+  Double_t* fHodoNegTwRef;
+  Double_t* fHodoTofSigma;	// Paddle time sigma in the start time and beta fits
+  Double_t* fHodoTofPosSigma;	// Same, positive or negative tube only
+  Double_t* fHodoTofNegSigma;
+  Double_t* fHodoTofWeight;	// 1/sigma^2 of the above
+  Double_t* fHodoTofPosWeight;
+  Double_t* fHodoTofNegWeight;
 
   Double_t fPartMass;		// Nominal particle mass
   Double_t fBetaNominal;	// Beta for central ray of nominal particle type
@@ -357,15 +387,16 @@ protected:
     Double_t scin_time;
     Double_t scin_time_fp;
     Double_t scin_sigma;
+    Double_t scin_weight;	// 1/scin_sigma^2
     Double_t dedx;
     TOFCalc() : good_scin_time(kFALSE), good_tdc_pos(kFALSE),
 		good_tdc_neg(kFALSE) {}
   };
   std::vector<TOFCalc> fTOFCalc;
-    // This doesn't work because we clear this structure each track
-    // Do we need an vector of vectors of structures?
-    // Start with a separate vector of vectors for now.
-  std::vector<std::vector<Double_t> > fdEdX;	        // Vector over track #
+  // dE/dx of the hits with a good time, for all tracks one after the
+  // other.  fdEdXOffset[itrack] is where the hits of a track start.
+  std::vector<Double_t> fdEdX;
+  std::vector<Int_t> fdEdXOffset;
   std::vector<Int_t > fNScinHit;		        // # scins hit for the track
   std::vector<std::vector<Int_t> > fScinHitPaddle;	// Vector over hits in a plane #
   std::vector<Int_t > fNClust;		                // # scins clusters for the plane
@@ -383,10 +414,26 @@ protected:
     GoodFlags() : onTrack(false), goodScinTime(false),
 		  goodTdcNeg(false), goodTdcPos(false) {}
   };
-  std::vector<std::vector<std::vector<GoodFlags> > > fGoodFlags;
+  // Flags of every hit for every track in one buffer, used by
+  // THcHodoEff.  The flags of hit ihit of plane iplane for track itrack
+  // are at fGoodFlagsOffset[itrack*fNumPlanesBetaCalc+iplane]+ihit.
+  // clear() keeps the capacity, so after the first events nothing is
+  // allocated.
+  std::vector<GoodFlags> fGoodFlags;
+  std::vector<Int_t> fGoodFlagsOffset;
+  GoodFlags& GetGoodFlags(Int_t itrack, Int_t iplane, Int_t ihit) {
+    return fGoodFlags[fGoodFlagsOffset[itrack*fNumPlanesBetaCalc+iplane]+ihit];
+  }
+  const GoodFlags& GetGoodFlags(Int_t itrack, Int_t iplane, Int_t ihit) const {
+    return fGoodFlags[fGoodFlagsOffset[itrack*fNumPlanesBetaCalc+iplane]+ihit];
+  }
+  std::vector<TrackProjection> fTrackProjection;	// Track * fNPlanes + plane
+  std::vector<Double_t> fNPmtHit;	// Per track, kept between events
+  std::vector<Double_t> fTimeAtFP;
   //
 
   void           DeleteArrays();
+  void           ProjectTracks( TClonesArray& tracks );
   virtual Int_t  ReadDatabase( const TDatime& date );
   virtual Int_t  DefineVariables( EMode mode = kDefine );
   enum ESide { kLeft = 0, kRight = 1 };
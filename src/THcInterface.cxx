@@ -13,6 +13,9 @@ for the Hall C style parameter database.
 #include "TInterpreter.h"
 #include "THcParmList.h"
 #include "THcDetectorMap.h"
+#include "THcRefTimeCache.h"
+#include "THcChannelOwnerMap.h"
+#include "THcDiagnostics.h"
 #include "THcGlobals.h"
 #include "ha_compiledata.h"
 #include "hc_compiledata.h"
@@ -28,6 +31,9 @@ using namespace std;
 
 THcParmList* gHcParms     = NULL;  // List of symbolic analyzer variables
 THcDetectorMap* gHcDetectorMap = NULL; // Global (Hall C style) detector map
+THcRefTimeCache* gHcRefTimeCache = NULL; // Reference times shared by hit lists
+THcChannelOwnerMap* gHcChannelOwnerMap = NULL; // Fired channels of all hit lists
+THcDiagnostics* gHcDiagnostics = NULL; // Rate-limited event loop warnings
 
 //_____________________________________________________________________________
 THcInterface::THcInterface( const char* appClassName, int* argc, char** argv,
@@ -49,6 +55,9 @@ This class is copy of THaInterface with the addition of of the global
 
   SetPrompt("hcana [%d] ");
   gHcParms    = new THcParmList;
+  gHcRefTimeCache = new THcRefTimeCache;
+  gHcChannelOwnerMap = new THcChannelOwnerMap;
+  gHcDiagnostics = new THcDiagnostics;
 
   // Jure update: 100 GB
   TTree::SetMaxTreeSize(100000000000LL);
@@ -63,6 +72,9 @@ THcInterface::~THcInterface()
 
   if( fgAint == this ) {
     delete gHcDetectorMap;   gHcDetectorMap=0;
+    delete gHcRefTimeCache;  gHcRefTimeCache=0;
+    delete gHcChannelOwnerMap;  gHcChannelOwnerMap=0;
+    delete gHcDiagnostics;  gHcDiagnostics=0;
   }
 }
 
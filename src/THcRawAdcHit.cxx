@@ -11,10 +11,22 @@ It supports rich data from flash 250 ADC modules.
 \brief Constructor.
 */
 
+/**
+\fn THcRawAdcHit::THcRawAdcHit(const THcRawAdcHit& right)
+\brief Copy constructor.
+\param[in] right Raw ADC hit to be copied.
+
+The copy keeps its own samples, so it stays valid after the arena of
+`right` is cleared.
+*/
+
 /**
 \fn THcRawAdcHit& THcRawAdcHit::operator=(const THcRawAdcHit& right)
 \brief Assignment operator.
 \param[in] right Raw ADC hit to be assigned.
+
+Like the copy constructor, the samples are copied into storage owned
+by this hit.
 */
 
 /**
@@ -28,6 +40,14 @@ It supports rich data from flash 250 ADC modules.
 \param[in] opt Maybe used in base clas... Not sure.
 */
 
+/**
+\fn void THcRawAdcHit::SetArena(THcRawDataArena* arena)
+\brief Sets the per-event storage that holds the samples.
+\param[in] arena Storage owned by the hit list.
+
+Without an arena, the hit keeps its samples in its own storage.
+*/
+
 /**
 \fn void THcRawAdcHit::SetData(Int_t data)
 \brief Sets raw ADC value.
@@ -44,6 +64,19 @@ Should be used for old style ADCs.
 \throw std::out_of_range Tried to set too many samples.
 */
 
+/**
+\fn void THcRawAdcHit::SetSampleSource(const THaEvData* evdata, Int_t crate, Int_t slot, Int_t chan)
+\brief Defers reading the samples of a channel until they are needed.
+\param[in] evdata Event data of the current event.
+\param[in] crate Crate of the channel.
+\param[in] slot Slot of the channel.
+\param[in] chan Channel.
+
+The samples are copied into the arena the first time any sample
+accessor is called.  Hits are cleared every event, so the source is
+never used after the event data has moved on.
+*/
+
 /**
 \fn void THcRawAdcHit::SetDataTimePedestalPeak(Int_t data, Int_t time, Int_t pedestal, Int_t peak)
 \brief Sets various bits of ADC data.
@@ -187,6 +220,7 @@ Returns 0 if no signal pedestal is set.
 #include "THcRawAdcHit.h"
 #include <stdexcept>
 #include "TString.h"
+#include "THaEvData.h"
     const Double_t THcRawAdcHit::fNAdcChan      = 4096.0; // Number of FADC channels in units of ADC channels
     const Double_t THcRawAdcHit::fAdcRange      = 1.0;    // Dynamic range of FADCs in units of V, // TO-DO: Get fAdcRange from pre-start event
     const Double_t THcRawAdcHit::fAdcImpedence  = 50.0;   // FADC input impedence in units of Ohms
@@ -198,10 +232,30 @@ THcRawAdcHit::THcRawAdcHit() :
   fNPedestalSamples(4), fNPeakSamples(9),
   fPeakPedestalRatio(1.0*fNPeakSamples/fNPedestalSamples),
   fSubsampleToTimeFactor(0.0625),
-  fPed(0), fPulseInt(), fPulseAmp(), fPulseTime(), fSample(),
-  fRefTime(0), fHasMulti(kFALSE), fHasRefTime(kFALSE), fNPulses(0), fNSamples(0)
+  fPed(0), fPulseInt(), fPulseAmp(), fPulseTime(), fArena(0), fSampleOffset(0),
+  fRefTime(0), fHasMulti(kFALSE), fHasRefTime(kFALSE), fNPulses(0), fNSamples(0),
+  fSampleSource(0), fSampleCrate(0), fSampleSlot(0), fSampleChan(0)
 {}
 
+THcRawAdcHit::THcRawAdcHit(const THcRawAdcHit& right) :
+  TObject(right),
+  fNPedestalSamples(right.fNPedestalSamples), fNPeakSamples(right.fNPeakSamples),
+  fPeakPedestalRatio(right.fPeakPedestalRatio),
+  fSubsampleToTimeFactor(right.fSubsampleToTimeFactor),
+  fPed(right.fPed), fArena(0), fSampleOffset(0),
+  fRefTime(right.fRefTime), fHasMulti(right.fHasMulti),
+  fHasRefTime(right.fHasRefTime), fNPulses(right.fNPulses), fNSamples(0),
+  fSampleSource(0), fSampleCrate(right.fSampleCrate),
+  fSampleSlot(right.fSampleSlot), fSampleChan(right.fSampleChan)
+{
+  for (UInt_t i=0; i<fMaxNPulses; ++i) {
+    fPulseInt[i]  = right.fPulseInt[i];
+    fPulseAmp[i]  = right.fPulseAmp[i];
+    fPulseTime[i] = right.fPulseTime[i];
+  }
+  CopySamples(right);
+}
+
 THcRawAdcHit& THcRawAdcHit::operator=(const THcRawAdcHit& right) {
   TObject::operator=(right);
 
@@ -212,14 +266,14 @@ THcRawAdcHit& THcRawAdcHit::operator=(const THcRawAdcHit& right) {
       fPulseAmp[i]  = right.fPulseAmp[i];
       fPulseTime[i] = right.fPulseTime[i];
     }
-    for (UInt_t i=0; i<fMaxNSamples; ++i) {
-      fSample[i] = right.fSample[i];
-    }
     fHasMulti = right.fHasMulti;
     fNPulses  = right.fNPulses;
-    fNSamples = right.fNSamples;
     fRefTime = right.fRefTime;
     fHasRefTime = right.fHasRefTime;
+    fSampleCrate = right.fSampleCrate;
+    fSampleSlot = right.fSampleSlot;
+    fSampleChan = right.fSampleChan;
+    CopySamples(right);
   }
 
   return *this;
@@ -236,14 +290,14 @@ void THcRawAdcHit::Clear(Option_t* opt) {
     fPulseAmp[i] = 0;
     fPulseTime[i] = 0;
   }
-  for (UInt_t i=0; i<fNSamples; ++i) {
-    fSample[i] = 0 ;
-  }
+  fSampleOffset = 0;
+  fOwnSamples.clear();
   fHasMulti = kFALSE;
   fNPulses = 0;
   fNSamples = 0;
   fRefTime = 0;
   fHasRefTime = kFALSE;
+  fSampleSource = 0;
 }
 
 void THcRawAdcHit::SetData(Int_t data) {
@@ -261,16 +315,79 @@ void THcRawAdcHit::SetRefTime(Int_t refTime) {
   fHasRefTime = kTRUE;
 }
 
+void THcRawAdcHit::SetArena(THcRawDataArena* arena) {
+  fArena = arena;
+}
+
 void THcRawAdcHit::SetSample(Int_t data) {
+  if (fSampleSource) LoadSamples();
   if (fNSamples >= fMaxNSamples) {
     throw std::out_of_range(
       "`THcRawAdcHit::SetSample`: too many samples!"
     );
   }
-  fSample[fNSamples] = data;
+  AppendSample(data);
+}
+
+void THcRawAdcHit::AppendSample(Int_t data) const {
+  if (fArena) {
+    fSampleOffset = fArena->Append(fSampleOffset, fNSamples, data);
+  }
+  else {
+    fOwnSamples.push_back(data);
+  }
   ++fNSamples;
 }
 
+const Int_t* THcRawAdcHit::GetSamples() const {
+  if (fArena) return fArena->GetData(fSampleOffset);
+  return &fOwnSamples[0];
+}
+
+void THcRawAdcHit::CopySamples(const THcRawAdcHit& right) {
+  // Detach from any arena and take a private copy of the samples.  Samples
+  // still in the event data are read now, the event will not outlive us.
+  if (right.fSampleSource) right.LoadSamples();
+  fArena = 0;
+  fSampleOffset = 0;
+  fSampleSource = 0;
+  fOwnSamples.clear();
+  fNSamples = 0;
+  if (right.fNSamples > 0) {
+    const Int_t* sample = right.GetSamples();
+    fOwnSamples.assign(sample, sample+right.fNSamples);
+    fNSamples = right.fNSamples;
+  }
+}
+
+void THcRawAdcHit::SetSampleSource(
+  const THaEvData* evdata, Int_t crate, Int_t slot, Int_t chan
+) {
+  fSampleSource = evdata;
+  fSampleCrate = crate;
+  fSampleSlot = slot;
+  fSampleChan = chan;
+}
+
+void THcRawAdcHit::LoadSamples() const {
+  const THaEvData* evdata = fSampleSource;
+  fSampleSource = 0;
+  Int_t nsamples = evdata->GetNumEvents(
+    Decoder::kSampleADC, fSampleCrate, fSampleSlot, fSampleChan
+  );
+  if (nsamples <= 0) return;
+  if (fNSamples+nsamples > fMaxNSamples) {
+    throw std::out_of_range(
+      "`THcRawAdcHit::LoadSamples`: too many samples!"
+    );
+  }
+  for (Int_t isamp=0; isamp<nsamples; ++isamp) {
+    AppendSample(
+      evdata->GetData(Decoder::kSampleADC, fSampleCrate, fSampleSlot, fSampleChan, isamp)
+    );
+  }
+}
+
 void THcRawAdcHit::SetDataTimePedestalPeak(
   Int_t data, Int_t time, Int_t pedestal, Int_t peak
 ) {
@@ -304,6 +421,7 @@ Int_t THcRawAdcHit::GetRawData(UInt_t iPulse) const {
 }
 
 Double_t THcRawAdcHit::GetAverage(UInt_t iSampleLow, UInt_t iSampleHigh) const {
+  if (fSampleSource) LoadSamples();
   if (iSampleHigh >= fNSamples || iSampleLow >= fNSamples) {
     TString msg = TString::Format(
       "`THcRawAdcHit::GetAverage`: not this many samples available!"
@@ -311,9 +429,10 @@ Double_t THcRawAdcHit::GetAverage(UInt_t iSampleLow, UInt_t iSampleHigh) const {
     throw std::out_of_range(msg.Data());
   }
   else {
+    const Int_t* sample = GetSamples();
     Double_t average = 0.0;
     for (UInt_t i=iSampleLow; i<=iSampleHigh; ++i) {
-      average += fSample[i];
+      average += sample[i];
     }
     return average / (iSampleHigh - iSampleLow + 1);
   }
@@ -321,6 +440,7 @@ Double_t THcRawAdcHit::GetAverage(UInt_t iSampleLow, UInt_t iSampleHigh) const {
 
 
 Int_t THcRawAdcHit::GetIntegral(UInt_t iSampleLow, UInt_t iSampleHigh) const {
+  if (fSampleSource) LoadSamples();
   if (iSampleHigh >= fNSamples || iSampleLow >= fNSamples) {
     TString msg = TString::Format(
       "`THcRawAdcHit::GetAverage`: not this many samples available!"
@@ -328,9 +448,10 @@ Int_t THcRawAdcHit::GetIntegral(UInt_t iSampleLow, UInt_t iSampleHigh) const {
     throw std::out_of_range(msg.Data());
   }
   else {
+    const Int_t* sample = GetSamples();
     Int_t integral = 0;
     for (UInt_t i=iSampleLow; i<=iSampleHigh; ++i) {
-      integral += fSample[i];
+      integral += sample[i];
     }
     return integral;
   }
@@ -349,6 +470,7 @@ UInt_t THcRawAdcHit::GetNPulses() const {
 }
 
 UInt_t THcRawAdcHit::GetNSamples() const {
+  if (fSampleSource) LoadSamples();
   return fNSamples;
 }
 
@@ -409,8 +531,9 @@ Int_t THcRawAdcHit::GetPulseTimeRaw(UInt_t iPulse) const {
 }
 
 Int_t THcRawAdcHit::GetSampleRaw(UInt_t iSample) const {
+  if (fSampleSource) LoadSamples();
   if (iSample < fNSamples) {
-    return fSample[iSample];
+    return GetSamples()[iSample];
   }
   else {
     TString msg = TString::Format(
@@ -442,16 +565,20 @@ Double_t THcRawAdcHit::GetPulseTime(UInt_t iPulse) const {
 }
 
 Int_t THcRawAdcHit::GetSampleIntRaw() const {
+  if (fSampleSource) LoadSamples();
   Int_t integral = 0;
+  if (fNSamples == 0) return integral;
 
+  const Int_t* sample = GetSamples();
   for (UInt_t iSample=0; iSample<fNSamples; ++iSample) {
-    integral += fSample[iSample];
+    integral += sample[iSample];
   }
 
   return integral;
 }
 
 Double_t THcRawAdcHit::GetSampleInt() const {
+  if (fSampleSource) LoadSamples();
   return static_cast<Double_t>(GetSampleIntRaw()) - GetPed()*static_cast<Double_t>(fNSamples);
 }
 
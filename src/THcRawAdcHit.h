@@ -2,18 +2,28 @@
 #define ROOT_THcRawAdcHit
 
 #include "TObject.h"
+#include "THcRawDataArena.h"
+
+#include <vector>
+
+class THaEvData;
 
 
 class THcRawAdcHit : public TObject {
   public:
     THcRawAdcHit();
+    THcRawAdcHit(const THcRawAdcHit& right);
     THcRawAdcHit& operator=(const THcRawAdcHit& right);
     virtual ~THcRawAdcHit();
 
     virtual void Clear(Option_t* opt="");
 
+    void SetArena(THcRawDataArena* arena);
     void SetData(Int_t data);
     void SetSample(Int_t data);
+    void SetSampleSource(
+      const THaEvData* evdata, Int_t crate, Int_t slot, Int_t chan
+    );
     void SetRefTime(Int_t refTime);
     void SetDataTimePedestalPeak(
       Int_t data, Int_t time, Int_t pedestal, Int_t peak
@@ -75,13 +85,26 @@ class THcRawAdcHit : public TObject {
     Int_t fPulseInt[fMaxNPulses];
     Int_t fPulseAmp[fMaxNPulses];
     Int_t fPulseTime[fMaxNPulses];
-    Int_t fSample[fMaxNSamples];
+    THcRawDataArena* fArena;  // Storage of the samples
+    mutable UInt_t fSampleOffset;     // Position of first sample in fArena
+    mutable std::vector<Int_t> fOwnSamples;  // Samples if no arena is set
     Int_t fRefTime;
 
     Bool_t fHasMulti;
     Bool_t fHasRefTime;
     UInt_t fNPulses;
-    UInt_t fNSamples;
+    mutable UInt_t fNSamples;
+
+    void AppendSample(Int_t data) const;
+    const Int_t* GetSamples() const;
+    void CopySamples(const THcRawAdcHit& right);
+
+    // Samples not yet copied from the event data
+    void LoadSamples() const;
+    mutable const THaEvData* fSampleSource;
+    Int_t fSampleCrate;
+    Int_t fSampleSlot;
+    Int_t fSampleChan;
 
   private:
     ClassDef(THcRawAdcHit, 0)
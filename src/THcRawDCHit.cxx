@@ -130,4 +130,9 @@ THcRawTdcHit& THcRawDCHit::GetRawTdcHit() {
 }
 
 
+void THcRawDCHit::SetArena(THcRawDataArena* arena) {
+  fTdcHit.SetArena(arena);
+}
+
+
 ClassImp(THcRawDCHit)
@@ -8,6 +8,7 @@
 class THcRawDCHit : public THcRawHit {
   friend class THcDriftChamberPlane;
   friend class THcDC;
+  friend struct THcRawHitParts<THcRawDCHit>;
 
   public:
     THcRawDCHit(Int_t plane=0, Int_t counter=0);
@@ -29,6 +30,8 @@ class THcRawDCHit : public THcRawHit {
 
     THcRawTdcHit& GetRawTdcHit();
 
+    virtual void SetArena(THcRawDataArena* arena);
+
   protected:
     static const Int_t fNTdcSignals = 1;
 
@@ -38,4 +41,16 @@ class THcRawDCHit : public THcRawHit {
     ClassDef(THcRawDCHit, 0);	// Raw Drift Chamber hit
 };
 
+template<> struct THcRawHitParts<THcRawDCHit> {
+  static THcRawAdcHit* Adc(THcRawDCHit&, Int_t) {
+    return 0;
+  }
+  static THcRawTdcHit* Tdc(THcRawDCHit& hit, Int_t signal) {
+    if (signal == 0) {
+      return &hit.fTdcHit;
+    }
+    return 0;
+  }
+};
+
 #endif
@@ -0,0 +1,66 @@
+/** \class THcRawDataArena
+    \ingroup DetSupport
+
+\brief Per-event storage for variable length raw hit data
+
+FADC samples and multihit TDC times are stored here instead of in
+fixed size arrays inside every THcRawAdcHit and THcRawTdcHit.  A raw
+hit holds only the offset and length of its words (a span).  Each
+THcHitList owns one arena and clears it at the start of every event.
+Clear() keeps the allocated capacity, so after the first few events
+no memory is allocated.
+
+Words for one hit are normally appended back to back.  If another
+hit was appended in between, the span is moved to the end of the
+arena first, so a span is always contiguous.
+
+*/
+#include "THcRawDataArena.h"
+
+using namespace std;
+
+THcRawDataArena::THcRawDataArena(UInt_t capacity)
+{
+  /// Normal constructor.
+  fData.reserve(capacity);
+}
+
+THcRawDataArena::~THcRawDataArena()
+{
+  /// Destructor
+}
+
+void THcRawDataArena::Clear(Option_t* opt)
+{
+  /// Forget all data of the current event.  Capacity is kept.
+  fData.clear();
+}
+
+UInt_t THcRawDataArena::Append(UInt_t offset, UInt_t n, Int_t value)
+{
+  /**
+\brief Append a word to a span
+
+\param[in] offset Start of the span in the arena
+\param[in] n Number of words in the span
+\param[in] value Word to append
+\return New start of the span, which has now n+1 words
+  */
+  UInt_t size = fData.size();
+  if(n == 0) {
+    fData.push_back(value);
+    return size;
+  }
+  if(offset + n != size) {
+    // Span is not at the end of the arena.  Move it there.
+    fData.resize(size + n);
+    for(UInt_t i=0; i<n; i++) {
+      fData[size+i] = fData[offset+i];
+    }
+    offset = size;
+  }
+  fData.push_back(value);
+  return offset;
+}
+
+ClassImp(THcRawDataArena)
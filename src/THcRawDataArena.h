@@ -0,0 +1,36 @@
+#ifndef ROOT_THcRawDataArena
+#define ROOT_THcRawDataArena
+
+//////////////////////////////////////////////////////////////////////////
+//
+// THcRawDataArena
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "TObject.h"
+
+#include <vector>
+
+class THcRawDataArena : public TObject {
+
+public:
+
+  THcRawDataArena(UInt_t capacity=4096);
+  virtual ~THcRawDataArena();
+
+  virtual void Clear(Option_t* opt="");
+
+  UInt_t Append(UInt_t offset, UInt_t n, Int_t value);
+
+  Int_t At(UInt_t i) const { return fData[i]; }
+  const Int_t* GetData(UInt_t offset) const { return &fData[offset]; }
+  UInt_t GetSize() const { return fData.size(); }
+  UInt_t GetCapacity() const { return fData.capacity(); }
+
+protected:
+
+  std::vector<Int_t> fData;	// Storage for the current event
+
+  ClassDef(THcRawDataArena,0);  // Per-event storage for raw hit words
+};
+#endif
@@ -8,6 +8,11 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "TObject.h"
 
+class THcRawDataArena;
+class THcRawAdcHit;
+class THcRawTdcHit;
+class THaEvData;
+
 class THcRawHit : public TObject {
 
 public:
@@ -31,6 +36,10 @@ public:
 
   virtual void SetData(Int_t signal, Int_t data) {};
   virtual void SetSample(Int_t signal, Int_t data) {};
+  // Defer copying samples until first use.  Returns kFALSE if the hit
+  // class cannot do that, in which case samples must go through SetSample.
+  virtual Bool_t SetSampleSource(Int_t signal, const THaEvData* evdata,
+				 Int_t crate, Int_t slot, Int_t chan) {return kFALSE;}
   virtual void SetDataTimePedestalPeak(Int_t signal, Int_t data,
 				       Int_t time, Int_t pedestal, Int_t peak) {};
   virtual Int_t GetData(Int_t signal) {return 0;}; /* Ref time subtracted */
@@ -44,6 +53,9 @@ public:
 
   virtual void SetF250Params(Int_t NSA, Int_t NSB, Int_t NPED) {};
 
+  // Per-event storage for samples and multihit times, set by THcHitList
+  virtual void SetArena(THcRawDataArena* arena) {};
+
   // Derived objects must be sortable and supply Compare method
   //  virtual Bool_t  IsSortable () const {return kFALSE; }
   //  virtual Int_t   Compare(const TObject* obj) const {return 0;}
@@ -58,4 +70,13 @@ public:
   ClassDef(THcRawHit,0)      // Raw Hit Base Class
 };
 
+// Direct access to the ADC and TDC parts of a raw hit class, so that
+// THcHitList can fill hits without the virtual Set methods.  Specialized
+// after each hit class.  A null part means the signal has to go through
+// the virtual methods, which is all the generic version offers.
+template<class Hit> struct THcRawHitParts {
+  static THcRawAdcHit* Adc(Hit&, Int_t) {return 0;}
+  static THcRawTdcHit* Tdc(Hit&, Int_t) {return 0;}
+};
+
 #endif
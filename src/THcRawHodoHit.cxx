@@ -79,6 +79,21 @@ void THcRawHodoHit::SetSample(Int_t signal, Int_t data) {
 }
 
 
+Bool_t THcRawHodoHit::SetSampleSource(
+  Int_t signal, const THaEvData* evdata, Int_t crate, Int_t slot, Int_t chan
+) {
+  if (0 <= signal && signal < fNAdcSignals) {
+    fAdcHits[signal].SetSampleSource(evdata, crate, slot, chan);
+    return kTRUE;
+  }
+  else {
+    throw std::out_of_range(
+      "`THcRawHodoHit::SetSampleSource`: only signals `0` and `1` available!"
+    );
+  }
+}
+
+
 void THcRawHodoHit::SetDataTimePedestalPeak(
   Int_t signal, Int_t data, Int_t time, Int_t pedestal, Int_t peak
 ) {
@@ -206,4 +221,14 @@ void THcRawHodoHit::SetF250Params(Int_t NSA, Int_t NSB, Int_t NPED) {
 }
 
 
+void THcRawHodoHit::SetArena(THcRawDataArena* arena) {
+  for (Int_t iAdcSig=0; iAdcSig<fNAdcSignals; ++iAdcSig) {
+    fAdcHits[iAdcSig].SetArena(arena);
+  }
+  for (Int_t iTdcSig=0; iTdcSig<fNTdcSignals; ++iTdcSig) {
+    fTdcHits[iTdcSig].SetArena(arena);
+  }
+}
+
+
 ClassImp(THcRawHodoHit)
@@ -10,6 +10,7 @@ class THcRawHodoHit : public THcRawHit {
   friend class THcScintillatorPlane;
   friend class THcHodoscope;
   friend class THcHodoHit;
+  friend struct THcRawHitParts<THcRawHodoHit>;
 
   public:
 
@@ -21,6 +22,9 @@ class THcRawHodoHit : public THcRawHit {
 
     virtual void SetData(Int_t signal, Int_t data);
     virtual void SetSample(Int_t signal, Int_t data);
+    virtual Bool_t SetSampleSource(
+      Int_t signal, const THaEvData* evdata, Int_t crate, Int_t slot, Int_t chan
+    );
     virtual void SetDataTimePedestalPeak(
       Int_t signal, Int_t data, Int_t time, Int_t pedestal, Int_t peak
     );
@@ -40,6 +44,7 @@ class THcRawHodoHit : public THcRawHit {
     THcRawTdcHit& GetRawTdcHitNeg();
 
     void SetF250Params(Int_t NSA, Int_t NSB, Int_t NPED);
+    virtual void SetArena(THcRawDataArena* arena);
 
   protected:
     static const Int_t fNAdcSignals = 2;
@@ -52,5 +57,21 @@ class THcRawHodoHit : public THcRawHit {
     ClassDef(THcRawHodoHit, 0);  // Raw Hodoscope hit
 };
 
+template<> struct THcRawHitParts<THcRawHodoHit> {
+  static THcRawAdcHit* Adc(THcRawHodoHit& hit, Int_t signal) {
+    if (0 <= signal && signal < THcRawHodoHit::fNAdcSignals) {
+      return &hit.fAdcHits[signal];
+    }
+    return 0;
+  }
+  static THcRawTdcHit* Tdc(THcRawHodoHit& hit, Int_t signal) {
+    Int_t iTdc = signal - THcRawHodoHit::fNAdcSignals;
+    if (0 <= iTdc && iTdc < THcRawHodoHit::fNTdcSignals) {
+      return &hit.fTdcHits[iTdc];
+    }
+    return 0;
+  }
+};
+
 
 #endif  // ROOT_THcRawHodoHit
@@ -68,6 +68,21 @@ void THcRawShowerHit::SetSample(Int_t signal, Int_t data) {
 }
 
 
+Bool_t THcRawShowerHit::SetSampleSource(
+  Int_t signal, const THaEvData* evdata, Int_t crate, Int_t slot, Int_t chan
+) {
+  if (0 <= signal && signal < fNAdcSignals) {
+    fAdcHits[signal].SetSampleSource(evdata, crate, slot, chan);
+    return kTRUE;
+  }
+  else {
+    throw std::out_of_range(
+      "`THcRawShowerHit::SetSampleSource`: only signals `0` and `1` available!"
+    );
+  }
+}
+
+
 void THcRawShowerHit::SetDataTimePedestalPeak(
   Int_t signal, Int_t data, Int_t time, Int_t pedestal, Int_t peak
 ) {
@@ -151,4 +166,11 @@ void THcRawShowerHit::SetF250Params(Int_t NSA, Int_t NSB, Int_t NPED) {
 }
 
 
+void THcRawShowerHit::SetArena(THcRawDataArena* arena) {
+  for (Int_t iAdcSig=0; iAdcSig<fNAdcSignals; ++iAdcSig) {
+    fAdcHits[iAdcSig].SetArena(arena);
+  }
+}
+
+
 ClassImp(THcRawShowerHit)
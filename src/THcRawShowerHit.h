@@ -8,6 +8,7 @@
 class THcRawShowerHit : public THcRawHit {
   friend class THcShowerPlane;
   friend class THcShowerArray;
+  friend struct THcRawHitParts<THcRawShowerHit>;
 
   public:
     THcRawShowerHit(Int_t plane=0, Int_t counter=0);
@@ -18,6 +19,9 @@ class THcRawShowerHit : public THcRawHit {
 
     virtual void SetData(Int_t signal, Int_t data);
     virtual void SetSample(Int_t signal, Int_t data);
+    virtual Bool_t SetSampleSource(
+      Int_t signal, const THaEvData* evdata, Int_t crate, Int_t slot, Int_t chan
+    );
     virtual void SetDataTimePedestalPeak(
       Int_t signal, Int_t data, Int_t time, Int_t pedestal, Int_t peak
     );
@@ -32,6 +36,7 @@ class THcRawShowerHit : public THcRawHit {
     THcRawAdcHit& GetRawAdcHitNeg();
 
     void SetF250Params(Int_t NSA, Int_t NSB, Int_t NPED);
+    virtual void SetArena(THcRawDataArena* arena);
 
   protected:
     static const Int_t fNAdcSignals = 2;
@@ -42,5 +47,17 @@ class THcRawShowerHit : public THcRawHit {
     ClassDef(THcRawShowerHit, 0);  // Raw Shower counter hit
 };
 
+template<> struct THcRawHitParts<THcRawShowerHit> {
+  static THcRawAdcHit* Adc(THcRawShowerHit& hit, Int_t signal) {
+    if (0 <= signal && signal < THcRawShowerHit::fNAdcSignals) {
+      return &hit.fAdcHits[signal];
+    }
+    return 0;
+  }
+  static THcRawTdcHit* Tdc(THcRawShowerHit&, Int_t) {
+    return 0;
+  }
+};
+
 
 #endif
@@ -9,10 +9,22 @@
 \brief Constructor.
 */
 
+/**
+\fn THcRawTdcHit::THcRawTdcHit(const THcRawTdcHit& right)
+\brief Copy constructor.
+\param[in] right Raw TDC hit to be copied.
+
+The copy keeps its own hit times, so it stays valid after the arena
+of `right` is cleared.
+*/
+
 /**
 \fn THcRawTdcHit& THcRawTdcHit::operator=(const THcRawTdcHit& right)
 \brief Assignment operator.
 \param[in] right Raw TDC hit to be assigned.
+
+Like the copy constructor, the hit times are copied into storage
+owned by this hit.
 */
 
 /**
@@ -26,6 +38,14 @@
 \param[in] opt Maybe used in base clas... Not sure.
 */
 
+/**
+\fn void THcRawTdcHit::SetArena(THcRawDataArena* arena)
+\brief Sets the per-event storage that holds the hit times.
+\param[in] arena Storage owned by the hit list.
+
+Without an arena, the hit keeps its times in its own storage.
+*/
+
 /**
 \fn void THcRawTdcHit::SetTime(Int_t time)
 \brief Sets raw TDC time from the modules. In channels.
@@ -83,16 +103,31 @@ Returned time is corrected for reference time, if available.
 THcRawTdcHit::THcRawTdcHit() :
   TObject(),
   fChannelToTimeFactor(0.1),
-  fTime(), fRefTime(0), fHasRefTime(kFALSE), fNHits(0)
+  fArena(0), fTimeOffset(0), fRefTime(0), fHasRefTime(kFALSE), fNHits(0)
 {}
 
 
+THcRawTdcHit::THcRawTdcHit(const THcRawTdcHit& right) :
+  TObject(right),
+  fChannelToTimeFactor(right.fChannelToTimeFactor),
+  fArena(0), fTimeOffset(0), fRefTime(right.fRefTime),
+  fHasRefTime(right.fHasRefTime), fNHits(right.fNHits)
+{
+  for (UInt_t iHit=0; iHit<fNHits; ++iHit) {
+    fOwnTimes.push_back(right.GetTimeRaw(iHit));
+  }
+}
+
+
 THcRawTdcHit& THcRawTdcHit::operator=(const THcRawTdcHit& right) {
   TObject::operator=(right);
 
   if (this != &right) {
-    for (UInt_t iHit=0; iHit<fMaxNHits; ++iHit) {
-      fTime[iHit] = right.fTime[iHit];
+    fArena = 0;
+    fTimeOffset = 0;
+    fOwnTimes.clear();
+    for (UInt_t iHit=0; iHit<right.fNHits; ++iHit) {
+      fOwnTimes.push_back(right.GetTimeRaw(iHit));
     }
     fRefTime = right.fRefTime;
     fHasRefTime = right.fHasRefTime;
@@ -109,18 +144,27 @@ THcRawTdcHit::~THcRawTdcHit() {}
 void THcRawTdcHit::Clear(Option_t* opt) {
   TObject::Clear(opt);
 
-  for (UInt_t iHit=0; iHit<fNHits; ++iHit) {
-    fTime[iHit] = 0;
-  }
+  fTimeOffset = 0;
+  fOwnTimes.clear();
   fRefTime = 0;
   fHasRefTime = kFALSE;
   fNHits = 0;
 }
 
 
+void THcRawTdcHit::SetArena(THcRawDataArena* arena) {
+  fArena = arena;
+}
+
+
 void THcRawTdcHit::SetTime(Int_t time) {
   if (fNHits < fMaxNHits) {
-    fTime[fNHits] = time;
+    if (fArena) {
+      fTimeOffset = fArena->Append(fTimeOffset, fNHits, time);
+    }
+    else {
+      fOwnTimes.push_back(time);
+    }
     ++fNHits;
   }
   else {
@@ -141,7 +185,7 @@ void THcRawTdcHit::SetRefTime(Int_t refTime) {
 
 Int_t THcRawTdcHit::GetTimeRaw(UInt_t iHit) const {
   if (iHit < fNHits) {
-    return fTime[iHit];
+    return fArena ? fArena->At(fTimeOffset+iHit) : fOwnTimes[iHit];
   }
   else if (iHit == 0) {
     return 0;
@@ -2,16 +2,21 @@
 #define ROOT_THcRawTdcHit
 
 #include "TObject.h"
+#include "THcRawDataArena.h"
+
+#include <vector>
 
 
 class THcRawTdcHit : public TObject {
   public:
     THcRawTdcHit();
+    THcRawTdcHit(const THcRawTdcHit& right);
     THcRawTdcHit& operator=(const THcRawTdcHit& right);
     virtual ~THcRawTdcHit();
 
     virtual void Clear(Option_t* opt="");
 
+    void SetArena(THcRawDataArena* arena);
     void SetTime(Int_t time);
     void SetRefTime(Int_t refTime);
 
@@ -28,7 +33,9 @@ class THcRawTdcHit : public TObject {
 
     Double_t fChannelToTimeFactor;
 
-    Int_t fTime[fMaxNHits];
+    THcRawDataArena* fArena;  // Storage of the hit times
+    UInt_t fTimeOffset;       // Position of first hit time in fArena
+    std::vector<Int_t> fOwnTimes;  // Hit times if no arena is set
     Int_t fRefTime;
 
     Bool_t fHasRefTime;
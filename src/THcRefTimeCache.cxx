@@ -0,0 +1,181 @@
+/** \class THcRefTimeCache
+    \ingroup Base
+
+\brief Event-level cache of reference times shared by all hit lists
+
+Several detectors read the same ROC reference channels.  Instead of
+each THcHitList scanning these channels and applying its reference
+time cut separately, the result for a (crate, slot, chan, cut policy)
+is computed the first time it is requested in an event and reused by
+all later requests in the same event.  FADC trigger time shifts are
+cached the same way.
+
+The cache must be emptied with Reset() before the first request of
+each event.  THcHitList::ResetEventCaches does this, called by
+THcAnalyzer before the apparatuses decode.  A single instance, gHcRefTimeCache, is shared by all
+hit lists.
+
+*/
+#include "THcRefTimeCache.h"
+
+using namespace std;
+
+THcRefTimeCache::THcRefTimeCache() :
+  fNLookups(0), fNFills(0)
+{
+  /// Normal constructor.
+}
+
+THcRefTimeCache::~THcRefTimeCache()
+{
+  /// Destructor
+}
+
+void THcRefTimeCache::Reset()
+{
+  /// Forget the cached values.  Call at the start of every event.
+  fRefTimes.clear();
+  fTrigTimeShifts.clear();
+}
+
+Bool_t THcRefTimeCache::GetTDCRefTime(const THaEvData& evdata, Int_t crate,
+				      Int_t slot, Int_t chan, Int_t cut,
+				      Bool_t best, Int_t& reftime)
+{
+  /**
+\brief Get the reference time of a TDC channel
+
+\param[in] evdata Event data
+\param[in] crate,slot,chan Reference channel
+\param[in] cut Only hits at least this big are taken
+\param[in] best If no hit makes the cut, take the last hit
+\param[out] reftime Reference time, if found
+\return kTRUE if a reference time was found
+  */
+  fNLookups++;
+  for(UInt_t i=0; i<fRefTimes.size(); i++) {
+    const RefTime& r = fRefTimes[i];
+    if(r.chan == chan && r.slot == slot && r.crate == crate && !r.isadc
+       && r.cut == cut && r.best == best) {
+      reftime = r.reftime;
+      return r.hashit;
+    }
+  }
+  fNFills++;
+
+  // Only take first hit in this reference channel that is bigger
+  // than the cut
+  Int_t nrefhits = evdata.GetNumHits(crate, slot, chan);
+  Bool_t goodreftime = kFALSE;
+  Int_t time = 0;
+  for(Int_t ihit=0; ihit<nrefhits; ihit++) {
+    time = evdata.GetData(crate, slot, chan, ihit);
+    if(time >= cut) {
+      goodreftime = kTRUE;
+      break;
+    }
+  }
+  RefTime r;
+  r.crate = crate;
+  r.slot = slot;
+  r.chan = chan;
+  r.isadc = kFALSE;
+  r.cut = cut;
+  r.best = best;
+  r.timeshift = 0;
+  r.hashit = goodreftime || (nrefhits>0 && best);
+  r.reftime = r.hashit ? time : 0;
+  fRefTimes.push_back(r);
+
+  reftime = r.reftime;
+  return r.hashit;
+}
+
+Bool_t THcRefTimeCache::GetADCRefTime(const THaEvData& evdata, Int_t crate,
+				      Int_t slot, Int_t chan, Int_t cut,
+				      Bool_t best, Int_t timeshift,
+				      Int_t& reftime)
+{
+  /**
+\brief Get the reference time of an FADC channel from its pulse times
+
+\param[in] evdata Event data
+\param[in] crate,slot,chan Reference channel
+\param[in] cut Only pulse times at least this big are taken
+\param[in] best If no pulse makes the cut, take the last pulse
+\param[in] timeshift Trigger time shift of the module (4 ns units)
+\param[out] reftime Reference time, if found
+\return kTRUE if a reference time was found
+  */
+  fNLookups++;
+  for(UInt_t i=0; i<fRefTimes.size(); i++) {
+    const RefTime& r = fRefTimes[i];
+    if(r.chan == chan && r.slot == slot && r.crate == crate && r.isadc
+       && r.cut == cut && r.best == best && r.timeshift == timeshift) {
+      reftime = r.reftime;
+      return r.hashit;
+    }
+  }
+  fNFills++;
+
+  Int_t nrefhits = evdata.GetNumEvents(Decoder::kPulseTime, crate, slot, chan);
+  Bool_t goodreftime = kFALSE;
+  Int_t time = 0;
+  for(Int_t ihit=0; ihit<nrefhits; ihit++) {
+    time = evdata.GetData(Decoder::kPulseTime, crate, slot, chan, ihit);
+    time += 64*timeshift;
+    if(time >= cut) {
+      goodreftime = kTRUE;
+      break;
+    }
+  }
+  RefTime r;
+  r.crate = crate;
+  r.slot = slot;
+  r.chan = chan;
+  r.isadc = kTRUE;
+  r.cut = cut;
+  r.best = best;
+  r.timeshift = timeshift;
+  r.hashit = goodreftime || (nrefhits>0 && best);
+  r.reftime = r.hashit ? time : 0;
+  fRefTimes.push_back(r);
+
+  reftime = r.reftime;
+  return r.hashit;
+}
+
+Int_t THcRefTimeCache::GetTrigTimeShift(const THaEvData& evdata, Int_t ticrate,
+					Int_t tislot, Int_t slot,
+					Decoder::Fadc250Module* fadc)
+{
+  /**
+\brief Get the trigger time shift of an FADC relative to the TI
+
+\param[in] evdata Event data
+\param[in] ticrate,tislot Location of the TI
+\param[in] slot Slot of the FADC in the TI crate
+\param[in] fadc The FADC module, or 0 if the slot has no FADC
+\return FADC trigger time minus TI time, 0 if no FADC
+  */
+  for(UInt_t i=0; i<fTrigTimeShifts.size(); i++) {
+    const TrigTimeShift& t = fTrigTimeShifts[i];
+    if(t.slot == slot && t.tislot == tislot && t.ticrate == ticrate) {
+      return t.shift;
+    }
+  }
+  TrigTimeShift t;
+  t.ticrate = ticrate;
+  t.tislot = tislot;
+  t.slot = slot;
+  t.shift = 0;
+  if(fadc) {
+#define FUDGE 7
+    Int_t titime = evdata.GetData(ticrate, tislot, 2, 0)-FUDGE;
+    t.shift = fadc->GetTriggerTime() - titime;
+  }
+  fTrigTimeShifts.push_back(t);
+  return t.shift;
+}
+
+ClassImp(THcRefTimeCache)
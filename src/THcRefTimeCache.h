@@ -0,0 +1,63 @@
+#ifndef ROOT_THcRefTimeCache
+#define ROOT_THcRefTimeCache
+
+//////////////////////////////////////////////////////////////////////////
+//
+// THcRefTimeCache
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "TObject.h"
+#include "THaEvData.h"
+#include "Fadc250Module.h"
+
+#include <vector>
+
+class THcRefTimeCache : public TObject {
+
+public:
+
+  THcRefTimeCache();
+  virtual ~THcRefTimeCache();
+
+  Bool_t GetTDCRefTime(const THaEvData& evdata, Int_t crate, Int_t slot,
+		       Int_t chan, Int_t cut, Bool_t best, Int_t& reftime);
+  Bool_t GetADCRefTime(const THaEvData& evdata, Int_t crate, Int_t slot,
+		       Int_t chan, Int_t cut, Bool_t best, Int_t timeshift,
+		       Int_t& reftime);
+  Int_t  GetTrigTimeShift(const THaEvData& evdata, Int_t ticrate, Int_t tislot,
+			  Int_t slot, Decoder::Fadc250Module* fadc);
+  void   Reset();
+
+  UInt_t GetNLookups() const { return fNLookups; }
+  UInt_t GetNFills() const { return fNFills; }
+
+protected:
+
+  struct RefTime {		// Reference time of one channel and cut policy
+    Int_t crate;
+    Int_t slot;
+    Int_t chan;
+    Bool_t isadc;
+    Int_t cut;
+    Bool_t best;
+    Int_t timeshift;		// FADC trigger time shift applied (ADC only)
+    Bool_t hashit;
+    Int_t reftime;
+  };
+  struct TrigTimeShift {	// FADC trigger time shift of one slot
+    Int_t ticrate;
+    Int_t tislot;
+    Int_t slot;
+    Int_t shift;
+  };
+
+  std::vector<RefTime> fRefTimes;
+  std::vector<TrigTimeShift> fTrigTimeShifts;
+
+  UInt_t fNLookups;		// Reference time queries
+  UInt_t fNFills;		// Queries that had to read the event data
+
+  ClassDef(THcRefTimeCache,0);  // Event-level cache of reference times
+};
+#endif
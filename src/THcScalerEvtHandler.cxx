@@ -46,6 +46,7 @@ To enable debugging you may try this in the setup script
 #include "THaEvData.h"
 #include "THcParmList.h"
 #include "THcGlobals.h"
+#include "THcDiagnostics.h"
 #include "THaGlobals.h"
 #include "TNamed.h"
 #include "TMath.h"
@@ -81,7 +82,8 @@ THcScalerEvtHandler::THcScalerEvtHandler(const char *name, const char* descripti
     fNormSlot(-1),
     dvars(0),dvars_prev_read(0), dvarsFirst(0), fScalerTree(0), fUseFirstEvent(kTRUE),
     fOnlySyncEvents(kFALSE), fOnlyBanks(kFALSE), fDelayedType(-1),
-    fClockChan(-1), fLastClock(0), fClockOverflows(0)
+    fClockChan(-1), fLastClock(0), fClockOverflows(0),
+    fDiagZeroDeltaTime(-1), fDiagBadIndex(-1)
 {
   fRocSet.clear();
   fModuleSet.clear();
@@ -367,9 +369,11 @@ Int_t THcScalerEvtHandler::AnalyzeBuffer(UInt_t* rdata, Bool_t onlysync)
   fLastClock = thisClock;
   fDeltaTime= fTotalTime - fPrevTotalTime;
   if (fDeltaTime==0) {
-    cout << " *******************   Severe Warning ****************************" << endl;
-    cout << " In THcScalerEvtHandler have found fDeltaTime is zero !!   " << endl;
-      cout << " ******************* Alert DAQ experts ****************************" << endl;
+    if(gHcDiagnostics->Count(fDiagZeroDeltaTime)) {
+      gHcDiagnostics->Keep(fDiagZeroDeltaTime,
+			   Form("Severe Warning: %s found fDeltaTime is zero at scaler event %d !! Alert DAQ experts",
+				fName.Data(), evcount));
+    }
   }
   fPrevTotalTime=fTotalTime;
   Int_t nscal=0;
@@ -466,7 +470,11 @@ Int_t THcScalerEvtHandler::AnalyzeBuffer(UInt_t* rdata, Bool_t onlysync)
 	}
       } 
       else {
-	cout << "THcScalerEvtHandler:: ERROR:: incorrect index "<<ivar<<"  "<<idx<<"  "<<ichan<<endl;
+	if(gHcDiagnostics->Count(fDiagBadIndex)) {
+	  gHcDiagnostics->Keep(fDiagBadIndex,
+			       Form("THcScalerEvtHandler:: ERROR:: incorrect index %d  %d  %d",
+				    (Int_t) ivar, (Int_t) idx, (Int_t) ichan));
+	}
       }
     }else{ // evcount != 0
       if (fDebugFile) *fDebugFile << "Debug dvars "<<i<<"   "<<ivar<<"  "<<idx<<"  "<<ichan<<endl;
@@ -541,7 +549,11 @@ Int_t THcScalerEvtHandler::AnalyzeBuffer(UInt_t* rdata, Bool_t onlysync)
 	  }
 	if (fDebugFile) *fDebugFile << "   dvars  "<<scalerloc[ivar]->ikind<<"  "<<dvars[ivar]<<endl;
       } else {
-	cout << "THcScalerEvtHandler:: ERROR:: incorrect index "<<ivar<<"  "<<idx<<"  "<<ichan<<endl;
+	if(gHcDiagnostics->Count(fDiagBadIndex)) {
+	  gHcDiagnostics->Keep(fDiagBadIndex,
+			       Form("THcScalerEvtHandler:: ERROR:: incorrect index %d  %d  %d",
+				    (Int_t) ivar, (Int_t) idx, (Int_t) ichan));
+	}
       }
     }
     
@@ -614,6 +626,12 @@ THaAnalysisObject::EStatus THcScalerEvtHandler::Init(const TDatime& date)
   cout << "Howdy !  We are initializing THcScalerEvtHandler !!   name =   "
         << fName << endl;
 
+  if(!gHcDiagnostics) gHcDiagnostics = new THcDiagnostics;
+  fDiagZeroDeltaTime = gHcDiagnostics->Register("scaler_zero_delta_time",
+						"Scaler events with zero clock interval");
+  fDiagBadIndex = gHcDiagnostics->Register("scaler_bad_index",
+					   "Scaler variables with incorrect index");
+
   if(eventtypes.size()==0) {
     eventtypes.push_back(0);  // Default Event Type
   }
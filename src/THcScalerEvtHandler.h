@@ -86,6 +86,8 @@ private:
    Int_t fClockChan;
    UInt_t fLastClock;
    Int_t fClockOverflows;
+   Int_t fDiagZeroDeltaTime;	// gHcDiagnostics message types
+   Int_t fDiagBadIndex;
    std::vector<UInt_t*> fDelayedEvents;
    std::set<UInt_t> fRocSet;
    std::set<UInt_t> fModuleSet;
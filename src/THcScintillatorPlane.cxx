@@ -9,7 +9,6 @@ The THcHodoscope class instatiates one of these objects per plane.
 #include "TMath.h"
 #include "THcScintillatorPlane.h"
 #include "TClonesArray.h"
-#include "THcSignalHit.h"
 #include "THcHodoHit.h"
 #include "THcGlobals.h"
 #include "THcParmList.h"
@@ -23,6 +22,7 @@ The THcHodoscope class instatiates one of these objects per plane.
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
+#include <algorithm>
 
 using namespace std;
 
@@ -34,17 +34,7 @@ THcScintillatorPlane::THcScintillatorPlane( const char* name,
 					    const Int_t planenum,
 					    THaDetectorBase* parent )
 : THaSubDetector(name,description,parent),
-  fParentHitList(0), frPosAdcErrorFlag(0), frNegAdcErrorFlag(0),
-  frPosTDCHits(0), frNegTDCHits(0), frPosADCHits(0), frNegADCHits(0),
-  frPosADCSums(0), frNegADCSums(0), frPosADCPeds(0), frNegADCPeds(0),
-  fHodoHits(0), frPosTdcTimeRaw(0), frPosAdcPedRaw(0),
-  frPosAdcPulseIntRaw(0), frPosAdcPulseAmpRaw(0),
-  frPosAdcPulseTimeRaw(0), frPosTdcTime(0), frPosAdcPed(0),
-  frPosAdcPulseInt(0), frPosAdcPulseAmp(0), frPosAdcPulseTime(0),
-  frNegTdcTimeRaw(0), frNegAdcPedRaw(0), frNegAdcPulseIntRaw(0),
-  frNegAdcPulseAmpRaw(0), frNegAdcPulseTimeRaw(0), frNegTdcTime(0),
-  frNegAdcPed(0), frNegAdcPulseInt(0), frNegAdcPulseAmp(0),
-  frNegAdcPulseTime(0), fPosCenter(0), fHodoPosMinPh(0),
+  fParentHitList(0), fHodoHits(0), fPosCenter(0), fHodoPosMinPh(0),
   fHodoNegMinPh(0), fHodoPosPhcCoeff(0), fHodoNegPhcCoeff(0),
   fHodoPosTimeOffset(0), fHodoNegTimeOffset(0), fHodoVelLight(0),
   fHodoPosInvAdcOffset(0), fHodoNegInvAdcOffset(0),
@@ -53,7 +43,8 @@ THcScintillatorPlane::THcScintillatorPlane( const char* name,
   fHodoPosInvAdcLinear(0), fHodoNegInvAdcLinear(0),
   fHodoPosInvAdcAdc(0), fHodoNegInvAdcAdc(0), fHodoVelFit(0),
   fHodoCableFit(0), fHodo_LCoeff(0), fHodoPos_c1(0), fHodoNeg_c1(0),
-  fHodoPos_c2(0), fHodoNeg_c2(0), fHodoSigma(0), fPosPedSum(0),
+  fHodoPos_c2(0), fHodoNeg_c2(0), fHodoPosTwRef(0), fHodoNegTwRef(0),
+  fHodoSigma(0), fPosPedSum(0),
   fPosPedSum2(0), fPosPedLimit(0), fPosPedCount(0), fNegPedSum(0),
   fNegPedSum2(0), fNegPedLimit(0), fNegPedCount(0), fPosPed(0),
   fPosSig(0), fPosThresh(0), fNegPed(0), fNegSig(0), fNegThresh(0)
@@ -61,42 +52,6 @@ THcScintillatorPlane::THcScintillatorPlane( const char* name,
   // Normal constructor with name and description
   fHodoHits = new TClonesArray("THcHodoHit",16);
 
-  frPosAdcErrorFlag = new TClonesArray("THcSignalHit", 16);
-  frNegAdcErrorFlag = new TClonesArray("THcSignalHit", 16);
-
-  frPosTDCHits = new TClonesArray("THcSignalHit",16);
-  frNegTDCHits = new TClonesArray("THcSignalHit",16);
-  frPosADCHits = new TClonesArray("THcSignalHit",16);
-  frNegADCHits = new TClonesArray("THcSignalHit",16);
-  frPosADCSums = new TClonesArray("THcSignalHit",16);
-  frNegADCSums = new TClonesArray("THcSignalHit",16);
-  frPosADCPeds = new TClonesArray("THcSignalHit",16);
-  frNegADCPeds = new TClonesArray("THcSignalHit",16);
-
-  frPosTdcTimeRaw      = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPedRaw       = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseIntRaw  = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseAmpRaw  = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseTimeRaw = new TClonesArray("THcSignalHit", 16);
-
-  frPosTdcTime      = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPed       = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseInt  = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseAmp  = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseTime = new TClonesArray("THcSignalHit", 16);
-
-  frNegTdcTimeRaw      = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPedRaw       = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseIntRaw  = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseAmpRaw  = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseTimeRaw = new TClonesArray("THcSignalHit", 16);
-
-  frNegTdcTime      = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPed       = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseInt  = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseAmp  = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseTime = new TClonesArray("THcSignalHit", 16);
-
   fPlaneNum = planenum;
   fTotPlanes = planenum;
   fNScinHits = 0;
@@ -108,42 +63,7 @@ THcScintillatorPlane::~THcScintillatorPlane()
   // Destructor
   if( fIsSetup )
     RemoveVariables();
-  delete  frPosAdcErrorFlag; frPosAdcErrorFlag = NULL;
-  delete  frNegAdcErrorFlag; frNegAdcErrorFlag = NULL;
-
   delete fHodoHits;
-  delete frPosTDCHits;
-  delete frNegTDCHits;
-  delete frPosADCHits;
-  delete frNegADCHits;
-  delete frPosADCSums;
-  delete frNegADCSums;
-  delete frPosADCPeds;
-  delete frNegADCPeds;
-
-  delete frPosTdcTimeRaw;
-  delete frPosAdcPedRaw;
-  delete frPosAdcPulseIntRaw;
-  delete frPosAdcPulseAmpRaw;
-  delete frPosAdcPulseTimeRaw;
-
-  delete frPosTdcTime;
-  delete frPosAdcPed;
-  delete frPosAdcPulseInt;
-  delete frPosAdcPulseAmp;
-  delete frPosAdcPulseTime;
-
-  delete frNegTdcTimeRaw;
-  delete frNegAdcPedRaw;
-  delete frNegAdcPulseIntRaw;
-  delete frNegAdcPulseAmpRaw;
-  delete frNegAdcPulseTimeRaw;
-
-  delete frNegTdcTime;
-  delete frNegAdcPed;
-  delete frNegAdcPulseInt;
-  delete frNegAdcPulseAmp;
-  delete frNegAdcPulseTime;
 
   delete [] fPosCenter; fPosCenter = 0;
 
@@ -171,6 +91,8 @@ THcScintillatorPlane::~THcScintillatorPlane()
   delete [] fHodoNeg_c1;                 fHodoNeg_c1 = NULL;
   delete [] fHodoPos_c2;                 fHodoPos_c2 = NULL;
   delete [] fHodoNeg_c2;                 fHodoNeg_c2 = NULL;
+  delete [] fHodoPosTwRef;               fHodoPosTwRef = NULL;
+  delete [] fHodoNegTwRef;               fHodoNegTwRef = NULL;
 
 
   delete [] fHodoVelLight; fHodoVelLight = NULL;
@@ -262,7 +184,6 @@ Int_t THcScintillatorPlane::ReadDatabase( const TDatime& date )
     {"tofusinginvadc",   &fTofUsingInvAdc,        kInt,            0,  1},
     {"hodo_adc_mode", &fADCMode, kInt, 0, 1},
     {"hodo_pedestal_scale", &fADCPedScaleFactor, kDouble, 0, 1},
-    {"hodo_adc_diag_cut", &fADCDiagCut, kInt, 0, 1},
     {"cosmicflag", &fCosmicFlag, kInt, 0, 1},
     {"hodo_debug_adc",  &fDebugAdc, kInt, 0, 1},
     {0}
@@ -273,10 +194,22 @@ Int_t THcScintillatorPlane::ReadDatabase( const TDatime& date )
   //fADCMode = kADCStandard;
   fADCMode = kADCDynamicPedestal;
   fADCPedScaleFactor = 1.0;
-  fADCDiagCut = 50.0;
   fCosmicFlag=0;
   gHcParms->LoadParmValues((DBRequest*)&list,prefix);
   if (fCosmicFlag==1) cout << " setup for cosmics in scint plane"<< endl;
+
+  // Paddles ordered by position, for FindPaddleRange
+  vector<pair<Double_t,Int_t> > bypos(fNelem);
+  for(Int_t i=0; i<(Int_t) fNelem; i++) {
+    bypos[i] = make_pair(fPosCenter[i]+fPosOffset, i);
+  }
+  sort(bypos.begin(), bypos.end());
+  fSortedPos.resize(fNelem);
+  fPaddleRank.resize(fNelem);
+  for(Int_t i=0; i<(Int_t) fNelem; i++) {
+    fSortedPos[i] = bypos[i].first;
+    fPaddleRank[bypos[i].second] = i;
+  }
   // cout << " cosmic flag = " << fCosmicFlag << endl;
   // fetch the parameter from the temporary list
 
@@ -322,6 +255,8 @@ Int_t THcScintillatorPlane::ReadDatabase( const TDatime& date )
   fHodoNeg_c1=new Double_t [fNelem];
   fHodoPos_c2=new Double_t [fNelem];
   fHodoNeg_c2=new Double_t [fNelem];
+  fHodoPosTwRef=new Double_t [fNelem];
+  fHodoNegTwRef=new Double_t [fNelem];
 
   for(Int_t j=0;j<(Int_t) fNelem;j++) {
     Int_t index=parent->GetScinIndex(fPlaneNum-1,j);
@@ -350,6 +285,8 @@ Int_t THcScintillatorPlane::ReadDatabase( const TDatime& date )
     fHodoNeg_c1[j] = parent->GetHodoNeg_c1(index);
     fHodoPos_c2[j] = parent->GetHodoPos_c2(index);
     fHodoNeg_c2[j] = parent->GetHodoNeg_c2(index);
+    fHodoPosTwRef[j] = parent->GetHodoPosTwRef(index);
+    fHodoNegTwRef[j] = parent->GetHodoNegTwRef(index);
    
     Double_t possigma = parent->GetHodoPosSigma(index);
     Double_t negsigma = parent->GetHodoNegSigma(index);
@@ -431,32 +368,32 @@ Int_t THcScintillatorPlane::DefineVariables( EMode mode )
 
   if (fDebugAdc) {
     RVarDef vars[] = {
-      {"posAdcErrorFlag", "Error Flag for When FPGA Fails", "frPosAdcErrorFlag.THcSignalHit.GetData()"},
-      {"negAdcErrorFlag", "Error Flag for When FPGA Fails", "frNegAdcErrorFlag.THcSignalHit.GetData()"},
-
-      {"posTdcTimeRaw",      "List of positive raw TDC values.",           "frPosTdcTimeRaw.THcSignalHit.GetData()"},
-      {"posAdcPedRaw",       "List of positive raw ADC pedestals",         "frPosAdcPedRaw.THcSignalHit.GetData()"},
-      {"posAdcPulseIntRaw",  "List of positive raw ADC pulse integrals.",  "frPosAdcPulseIntRaw.THcSignalHit.GetData()"},
-      {"posAdcPulseAmpRaw",  "List of positive raw ADC pulse amplitudes.", "frPosAdcPulseAmpRaw.THcSignalHit.GetData()"},
-      {"posAdcPulseTimeRaw", "List of positive raw ADC pulse times.",      "frPosAdcPulseTimeRaw.THcSignalHit.GetData()"},
-
-      {"posTdcTime",         "List of positive TDC values.",               "frPosTdcTime.THcSignalHit.GetData()"},
-      {"posAdcPed",          "List of positive ADC pedestals",             "frPosAdcPed.THcSignalHit.GetData()"},
-      {"posAdcPulseInt",     "List of positive ADC pulse integrals.",      "frPosAdcPulseInt.THcSignalHit.GetData()"},
-      {"posAdcPulseAmp",     "List of positive ADC pulse amplitudes.",     "frPosAdcPulseAmp.THcSignalHit.GetData()"},
-      {"posAdcPulseTime",    "List of positive ADC pulse times.",          "frPosAdcPulseTime.THcSignalHit.GetData()"},
-
-      {"negTdcTimeRaw",      "List of negative raw TDC values.",           "frNegTdcTimeRaw.THcSignalHit.GetData()"},
-      {"negAdcPedRaw",       "List of negative raw ADC pedestals",         "frNegAdcPedRaw.THcSignalHit.GetData()"},
-      {"negAdcPulseIntRaw",  "List of negative raw ADC pulse integrals.",  "frNegAdcPulseIntRaw.THcSignalHit.GetData()"},
-      {"negAdcPulseAmpRaw",  "List of negative raw ADC pulse amplitudes.", "frNegAdcPulseAmpRaw.THcSignalHit.GetData()"},
-      {"negAdcPulseTimeRaw", "List of negative raw ADC pulse times.",      "frNegAdcPulseTimeRaw.THcSignalHit.GetData()"},
-
-      {"negTdcTime",         "List of negative TDC values.",               "frNegTdcTime.THcSignalHit.GetData()"},
-      {"negAdcPed",          "List of negative ADC pedestals",             "frNegAdcPed.THcSignalHit.GetData()"},
-      {"negAdcPulseInt",     "List of negative ADC pulse integrals.",      "frNegAdcPulseInt.THcSignalHit.GetData()"},
-      {"negAdcPulseAmp",     "List of negative ADC pulse amplitudes.",     "frNegAdcPulseAmp.THcSignalHit.GetData()"},
-      {"negAdcPulseTime",    "List of negative ADC pulse times.",          "frNegAdcPulseTime.THcSignalHit.GetData()"},
+      {"posAdcErrorFlag", "Error Flag for When FPGA Fails", "fPosAdcErrorFlag"},
+      {"negAdcErrorFlag", "Error Flag for When FPGA Fails", "fNegAdcErrorFlag"},
+
+      {"posTdcTimeRaw",      "List of positive raw TDC values.",           "fPosTdcTimeRaw"},
+      {"posAdcPedRaw",       "List of positive raw ADC pedestals",         "fPosAdcPedRaw"},
+      {"posAdcPulseIntRaw",  "List of positive raw ADC pulse integrals.",  "fPosAdcPulseIntRaw"},
+      {"posAdcPulseAmpRaw",  "List of positive raw ADC pulse amplitudes.", "fPosAdcPulseAmpRaw"},
+      {"posAdcPulseTimeRaw", "List of positive raw ADC pulse times.",      "fPosAdcPulseTimeRaw"},
+
+      {"posTdcTime",         "List of positive TDC values.",               "fPosTdcTime"},
+      {"posAdcPed",          "List of positive ADC pedestals",             "fPosAdcPed"},
+      {"posAdcPulseInt",     "List of positive ADC pulse integrals.",      "fPosAdcPulseInt"},
+      {"posAdcPulseAmp",     "List of positive ADC pulse amplitudes.",     "fPosAdcPulseAmp"},
+      {"posAdcPulseTime",    "List of positive ADC pulse times.",          "fPosAdcPulseTime"},
+
+      {"negTdcTimeRaw",      "List of negative raw TDC values.",           "fNegTdcTimeRaw"},
+      {"negAdcPedRaw",       "List of negative raw ADC pedestals",         "fNegAdcPedRaw"},
+      {"negAdcPulseIntRaw",  "List of negative raw ADC pulse integrals.",  "fNegAdcPulseIntRaw"},
+      {"negAdcPulseAmpRaw",  "List of negative raw ADC pulse amplitudes.", "fNegAdcPulseAmpRaw"},
+      {"negAdcPulseTimeRaw", "List of negative raw ADC pulse times.",      "fNegAdcPulseTimeRaw"},
+
+      {"negTdcTime",         "List of negative TDC values.",               "fNegTdcTime"},
+      {"negAdcPed",          "List of negative ADC pedestals",             "fNegAdcPed"},
+      {"negAdcPulseInt",     "List of negative ADC pulse integrals.",      "fNegAdcPulseInt"},
+      {"negAdcPulseAmp",     "List of negative ADC pulse amplitudes.",     "fNegAdcPulseAmp"},
+      {"negAdcPulseTime",    "List of negative ADC pulse times.",          "fNegAdcPulseTime"},
 
       {"totNumPosAdcHits", "Total Number of Positive ADC Hits",   "fTotNumPosAdcHits"}, // Hodo+ raw ADC multiplicity Int_t
       {"totNumNegAdcHits", "Total Number of Negative ADC Hits",   "fTotNumNegAdcHits"}, // Hodo- raw ADC multiplicity  ""
@@ -473,10 +410,10 @@ Int_t THcScintillatorPlane::DefineVariables( EMode mode )
   RVarDef vars[] = {
     {"nhits", "Number of paddle hits (passed TDC && ADC Min and Max cuts for either end)",           "GetNScinHits() "},
 
-    {"posTdcCounter", "List of positive TDC counter numbers.", "frPosTdcTimeRaw.THcSignalHit.GetPaddleNumber()"},   //Hodo+ raw TDC occupancy
-    {"posAdcCounter", "List of positive ADC counter numbers.", "frPosAdcPulseIntRaw.THcSignalHit.GetPaddleNumber()"}, //Hodo+ raw ADC occupancy
-    {"negTdcCounter", "List of negative TDC counter numbers.", "frNegTdcTimeRaw.THcSignalHit.GetPaddleNumber()"},     //Hodo- raw TDC occupancy
-    {"negAdcCounter", "List of negative ADC counter numbers.", "frNegAdcPulseIntRaw.THcSignalHit.GetPaddleNumber()"},  //Hodo- raw ADC occupancy
+    {"posTdcCounter", "List of positive TDC counter numbers.", "fPosTdcCounter"},   //Hodo+ raw TDC occupancy
+    {"posAdcCounter", "List of positive ADC counter numbers.", "fPosAdcCounter"}, //Hodo+ raw ADC occupancy
+    {"negTdcCounter", "List of negative TDC counter numbers.", "fNegTdcCounter"},     //Hodo- raw TDC occupancy
+    {"negAdcCounter", "List of negative ADC counter numbers.", "fNegAdcCounter"},  //Hodo- raw ADC occupancy
 
     {"fptime", "Time at focal plane",     "GetFpTime()"},
 
@@ -536,44 +473,14 @@ Int_t THcScintillatorPlane::DefineVariables( EMode mode )
 //_____________________________________________________________________________
 void THcScintillatorPlane::Clear( Option_t* )
 {
-  /*! \brief Clears fHodoHits,frPosTDCHits,frNegTDCHits,frPosADCHits,frNegADCHits
+  /*! \brief Clears fHodoHits and the raw TDC and ADC hit lists
    *
-   * -  Clears fHodoHits,frPosTDCHits,frNegTDCHits,frPosADCHits,frNegADCHits
+   * -  Clears fHodoHits and the raw TDC and ADC hit lists
    */
   //cout << " Calling THcScintillatorPlane::Clear " << GetName() << endl;
   // Clears the hit lists
-  frPosAdcErrorFlag->Clear();
-  frNegAdcErrorFlag->Clear();
-
   fHodoHits->Clear();
-  frPosTDCHits->Clear();
-  frNegTDCHits->Clear();
-  frPosADCHits->Clear();
-  frNegADCHits->Clear();
-
-  frPosTdcTimeRaw->Clear();
-  frPosAdcPedRaw->Clear();
-  frPosAdcPulseIntRaw->Clear();
-  frPosAdcPulseAmpRaw->Clear();
-  frPosAdcPulseTimeRaw->Clear();
-
-  frPosTdcTime->Clear();
-  frPosAdcPed->Clear();
-  frPosAdcPulseInt->Clear();
-  frPosAdcPulseAmp->Clear();
-  frPosAdcPulseTime->Clear();
-
-  frNegTdcTimeRaw->Clear();
-  frNegAdcPedRaw->Clear();
-  frNegAdcPulseIntRaw->Clear();
-  frNegAdcPulseAmpRaw->Clear();
-  frNegAdcPulseTimeRaw->Clear();
-
-  frNegTdcTime->Clear();
-  frNegAdcPed->Clear();
-  frNegAdcPulseInt->Clear();
-  frNegAdcPulseAmp->Clear();
-  frNegAdcPulseTime->Clear();
+  ClearRawHitLists();
 
   //Clear occupancies
   for (UInt_t ielem = 0; ielem < fNumGoodPosAdcHits.size(); ielem++)
@@ -663,6 +570,67 @@ Int_t THcScintillatorPlane::FineProcess( TClonesArray& tracks )
 }
 
 
+//_____________________________________________________________________________
+void THcScintillatorPlane::FindPaddleRange(Double_t pos, Double_t halfwidth,
+					   Int_t& first, Int_t& last) const
+{
+  /*! \brief Paddles with center (including the plane offset) closer than halfwidth to pos
+   *
+   * - Returns the ranks first to last-1 in position order.  Use
+   *   IsPaddleInRange to test a paddle.
+   * - Binary search, then the ends are checked with the same
+   *   TMath::Abs(center - pos) < halfwidth comparison as a direct loop
+   *   over the paddles would use
+   */
+  Int_t n = fSortedPos.size();
+  first = upper_bound(fSortedPos.begin(), fSortedPos.end(), pos-halfwidth)
+    - fSortedPos.begin();
+  last = lower_bound(fSortedPos.begin(), fSortedPos.end(), pos+halfwidth)
+    - fSortedPos.begin();
+  if(last < first) last = first;
+  while(first > 0 && TMath::Abs(fSortedPos[first-1] - pos) < halfwidth) first--;
+  while(first < last && !(TMath::Abs(fSortedPos[first] - pos) < halfwidth)) first++;
+  while(last < n && TMath::Abs(fSortedPos[last] - pos) < halfwidth) last++;
+  while(last > first && !(TMath::Abs(fSortedPos[last-1] - pos) < halfwidth)) last--;
+}
+
+//_____________________________________________________________________________
+void THcScintillatorPlane::ClearRawHitLists()
+{
+  /*! \brief Empties the raw TDC and ADC hit lists
+   *
+   * - The lists keep their capacity, so nothing is allocated once they
+   *   are as long as the largest event seen
+   */
+  fPosTdcCounter.clear();
+  fPosTdcTimeRaw.clear();
+  fPosTdcTime.clear();
+  fPosAdcCounter.clear();
+  fPosAdcPedRaw.clear();
+  fPosAdcPed.clear();
+  fPosAdcPulseIntRaw.clear();
+  fPosAdcPulseInt.clear();
+  fPosAdcPulseAmpRaw.clear();
+  fPosAdcPulseAmp.clear();
+  fPosAdcPulseTimeRaw.clear();
+  fPosAdcPulseTime.clear();
+  fPosAdcErrorFlag.clear();
+
+  fNegTdcCounter.clear();
+  fNegTdcTimeRaw.clear();
+  fNegTdcTime.clear();
+  fNegAdcCounter.clear();
+  fNegAdcPedRaw.clear();
+  fNegAdcPed.clear();
+  fNegAdcPulseIntRaw.clear();
+  fNegAdcPulseInt.clear();
+  fNegAdcPulseAmpRaw.clear();
+  fNegAdcPulseAmp.clear();
+  fNegAdcPulseTimeRaw.clear();
+  fNegAdcPulseTime.clear();
+  fNegAdcErrorFlag.clear();
+}
+
 //_____________________________________________________________________________
 Int_t THcScintillatorPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
 {
@@ -670,8 +638,7 @@ Int_t THcScintillatorPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
    * - Called by THcHodoscope::Decode
    * - Loops through "rawhits" array  starting at index of "nexthit"
    * - Assumes that the hit list is sorted by plane and looping ends when plane number of hit doesn't match fPlaneNum
-   * - Fills THcSignalHit objects frPosTDCHits and frNegTDCHits when TDC > 0
-   * - Fills THcSignalHit objects frPosADCHits and frNegADCHit with pedestal subtracted ADC when value larger than 50
+   * - Fills the raw TDC and ADC hit lists (fPosTdcTime, fPosAdcPulseInt, ...), one entry per TDC hit or ADC pulse
    * - For hits that have TDC value for either positive or negative PMT within  fScinTdcMin and fScinTdcMax
    *  + Creates new  fHodoHits[fNScinHits] =  THcHodoHit
    *  + Calculates pulse height correction to the positive and negative PMT times
@@ -683,47 +650,7 @@ Int_t THcScintillatorPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
    *
    */
   //raw
-  Int_t nrPosTDCHits=0;
-  Int_t nrNegTDCHits=0;
-  Int_t nrPosADCHits=0;
-  Int_t nrNegADCHits=0;
-  UInt_t nrPosAdcHits = 0;
-  UInt_t nrNegAdcHits = 0;
-  UInt_t nrPosTdcHits = 0;
-  UInt_t nrNegTdcHits = 0;
-  frPosTDCHits->Clear();
-  frNegTDCHits->Clear();
-  frPosADCHits->Clear();
-  frNegADCHits->Clear();
-  frPosADCSums->Clear();
-  frNegADCSums->Clear();
-  frPosADCPeds->Clear();
-  frNegADCPeds->Clear();
-
-
-  frPosTdcTimeRaw->Clear();
-  frPosAdcPedRaw->Clear();
-  frPosAdcPulseIntRaw->Clear();
-  frPosAdcPulseAmpRaw->Clear();
-  frPosAdcPulseTimeRaw->Clear();
-
-  frPosTdcTime->Clear();
-  frPosAdcPed->Clear();
-  frPosAdcPulseInt->Clear();
-  frPosAdcPulseAmp->Clear();
-  frPosAdcPulseTime->Clear();
-
-  frNegTdcTimeRaw->Clear();
-  frNegAdcPedRaw->Clear();
-  frNegAdcPulseIntRaw->Clear();
-  frNegAdcPulseAmpRaw->Clear();
-  frNegAdcPulseTimeRaw->Clear();
-
-  frNegTdcTime->Clear();
-  frNegAdcPed->Clear();
-  frNegAdcPulseInt->Clear();
-  frNegAdcPulseAmp->Clear();
-  frNegAdcPulseTime->Clear();
+  ClearRawHitLists();
 
   //stripped
   fNScinHits=0;
@@ -771,70 +698,55 @@ Int_t THcScintillatorPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
 
     THcRawTdcHit& rawPosTdcHit = hit->GetRawTdcHitPos();
     for (UInt_t thit=0; thit<rawPosTdcHit.GetNHits(); ++thit) {
-      ((THcSignalHit*) frPosTdcTimeRaw->ConstructedAt(nrPosTdcHits))->Set(padnum, rawPosTdcHit.GetTimeRaw(thit));
-      ((THcSignalHit*) frPosTdcTime->ConstructedAt(nrPosTdcHits))->Set(padnum, rawPosTdcHit.GetTime(thit));
-      ++nrPosTdcHits;
+      fPosTdcCounter.push_back(padnum);
+      fPosTdcTimeRaw.push_back(rawPosTdcHit.GetTimeRaw(thit));
+      fPosTdcTime.push_back(rawPosTdcHit.GetTime(thit));
       fTotNumTdcHits++;
       fTotNumPosTdcHits++;
     }
     THcRawTdcHit& rawNegTdcHit = hit->GetRawTdcHitNeg();
     for (UInt_t thit=0; thit<rawNegTdcHit.GetNHits(); ++thit) {
-      ((THcSignalHit*) frNegTdcTimeRaw->ConstructedAt(nrNegTdcHits))->Set(padnum, rawNegTdcHit.GetTimeRaw(thit));
-      ((THcSignalHit*) frNegTdcTime->ConstructedAt(nrNegTdcHits))->Set(padnum, rawNegTdcHit.GetTime(thit));
-      ++nrNegTdcHits;
+      fNegTdcCounter.push_back(padnum);
+      fNegTdcTimeRaw.push_back(rawNegTdcHit.GetTimeRaw(thit));
+      fNegTdcTime.push_back(rawNegTdcHit.GetTime(thit));
       fTotNumTdcHits++;
       fTotNumNegTdcHits++;
     }
     THcRawAdcHit& rawPosAdcHit = hit->GetRawAdcHitPos();
     for (UInt_t thit=0; thit<rawPosAdcHit.GetNPulses(); ++thit) {
-      ((THcSignalHit*) frPosAdcPedRaw->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPedRaw());
-      ((THcSignalHit*) frPosAdcPed->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPed());
-
-      ((THcSignalHit*) frPosAdcPulseIntRaw->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseIntRaw(thit));
-      ((THcSignalHit*) frPosAdcPulseInt->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseInt(thit));
-
-      ((THcSignalHit*) frPosAdcPulseAmpRaw->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseAmpRaw(thit));
-
-      ((THcSignalHit*) frPosAdcPulseAmp->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseAmp(thit));
+      fPosAdcCounter.push_back(padnum);
+      fPosAdcPedRaw.push_back(rawPosAdcHit.GetPedRaw());
+      fPosAdcPed.push_back(rawPosAdcHit.GetPed());
+      fPosAdcPulseIntRaw.push_back(rawPosAdcHit.GetPulseIntRaw(thit));
+      fPosAdcPulseInt.push_back(rawPosAdcHit.GetPulseInt(thit));
+      fPosAdcPulseAmpRaw.push_back(rawPosAdcHit.GetPulseAmpRaw(thit));
+      fPosAdcPulseAmp.push_back(rawPosAdcHit.GetPulseAmp(thit));
+      fPosAdcPulseTimeRaw.push_back(rawPosAdcHit.GetPulseTimeRaw(thit));
+      fPosAdcPulseTime.push_back(rawPosAdcHit.GetPulseTime(thit)+fAdcTdcOffset);
+      fPosAdcErrorFlag.push_back(rawPosAdcHit.GetPulseAmpRaw(thit) > 0 ? 0 : 1);
 
-      ((THcSignalHit*) frPosAdcPulseTimeRaw->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseTimeRaw(thit));
-      ((THcSignalHit*) frPosAdcPulseTime->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseTime(thit)+fAdcTdcOffset);
-
-      if (rawPosAdcHit.GetPulseAmpRaw(thit) > 0)  ((THcSignalHit*) frPosAdcErrorFlag->ConstructedAt(nrPosAdcHits))->Set(padnum, 0);
-      if (rawPosAdcHit.GetPulseAmpRaw(thit) <= 0) ((THcSignalHit*) frPosAdcErrorFlag->ConstructedAt(nrPosAdcHits))->Set(padnum, 1);
-
-      ++nrPosAdcHits;
       fTotNumAdcHits++;
       fTotNumPosAdcHits++;
     }
     THcRawAdcHit& rawNegAdcHit = hit->GetRawAdcHitNeg();
     for (UInt_t thit=0; thit<rawNegAdcHit.GetNPulses(); ++thit) {
-      ((THcSignalHit*) frNegAdcPedRaw->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPedRaw());
-      ((THcSignalHit*) frNegAdcPed->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPed());
-
-      ((THcSignalHit*) frNegAdcPulseIntRaw->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseIntRaw(thit));
-      ((THcSignalHit*) frNegAdcPulseInt->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseInt(thit));
-
-      ((THcSignalHit*) frNegAdcPulseAmpRaw->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseAmpRaw(thit));
-      ((THcSignalHit*) frNegAdcPulseAmp->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseAmp(thit));
-      ((THcSignalHit*) frNegAdcPulseTimeRaw->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseTimeRaw(thit));
-      ((THcSignalHit*) frNegAdcPulseTime->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseTime(thit)+fAdcTdcOffset);
+      fNegAdcCounter.push_back(padnum);
+      fNegAdcPedRaw.push_back(rawNegAdcHit.GetPedRaw());
+      fNegAdcPed.push_back(rawNegAdcHit.GetPed());
+      fNegAdcPulseIntRaw.push_back(rawNegAdcHit.GetPulseIntRaw(thit));
+      fNegAdcPulseInt.push_back(rawNegAdcHit.GetPulseInt(thit));
+      fNegAdcPulseAmpRaw.push_back(rawNegAdcHit.GetPulseAmpRaw(thit));
+      fNegAdcPulseAmp.push_back(rawNegAdcHit.GetPulseAmp(thit));
+      fNegAdcPulseTimeRaw.push_back(rawNegAdcHit.GetPulseTimeRaw(thit));
+      fNegAdcPulseTime.push_back(rawNegAdcHit.GetPulseTime(thit)+fAdcTdcOffset);
+      fNegAdcErrorFlag.push_back(rawNegAdcHit.GetPulseAmpRaw(thit) > 0 ? 0 : 1);
 
-      if (rawNegAdcHit.GetPulseAmpRaw(thit) > 0)  ((THcSignalHit*) frNegAdcErrorFlag->ConstructedAt(nrNegAdcHits))->Set(padnum, 0);
-      if (rawNegAdcHit.GetPulseAmpRaw(thit) <= 0) ((THcSignalHit*) frNegAdcErrorFlag->ConstructedAt(nrNegAdcHits))->Set(padnum, 1);
-
-      ++nrNegAdcHits;
       fTotNumAdcHits++;
       fTotNumNegAdcHits++;
     }
 
-    // Need to be finding first hit in TDC range, not the first hit overall
-    if (hit->GetRawTdcHitPos().GetNHits() > 0)
-      ((THcSignalHit*) frPosTDCHits->ConstructedAt(nrPosTDCHits++))->Set(padnum, hit->GetRawTdcHitPos().GetTime()+fTdcOffset);
-    if (hit->GetRawTdcHitNeg().GetNHits() > 0)
-      ((THcSignalHit*) frNegTDCHits->ConstructedAt(nrNegTDCHits++))->Set(padnum, hit->GetRawTdcHitNeg().GetTime()+fTdcOffset);
     // Should we make lists of offset corrected ADC Pulse times here too?  For now
-    // the frNegAdcPulseTime frPosAdcPulseTime have that offset correction.
+    // the fNegAdcPulseTime fPosAdcPulseTime have that offset correction.
     //
     Bool_t badcraw_pos=kFALSE;
     Bool_t badcraw_neg=kFALSE;
@@ -940,20 +852,6 @@ Int_t THcScintillatorPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
       adcint_neg = hit->GetRawAdcHitNeg().GetPulseIntRaw()-fNegPed[index];
       badcraw_pos = badcraw_neg = kTRUE;
     }
-    if (adcint_pos >= fADCDiagCut) {
-      ((THcSignalHit*) frPosADCHits->ConstructedAt(nrPosADCHits))->Set(padnum, adcint_pos);
-      Double_t samplesum=hit->GetRawAdcHitPos().GetSampleIntRaw();
-      Double_t pedestal=hit->GetRawAdcHitPos().GetPedRaw();
-      ((THcSignalHit*) frPosADCSums->ConstructedAt(nrPosADCHits))->Set(padnum, samplesum);
-      ((THcSignalHit*) frPosADCPeds->ConstructedAt(nrPosADCHits++))->Set(padnum, pedestal);
-    }
-    if (adcint_neg >= fADCDiagCut) {
-      ((THcSignalHit*) frNegADCHits->ConstructedAt(nrNegADCHits))->Set(padnum, adcint_neg);
-      Double_t samplesum=hit->GetRawAdcHitNeg().GetSampleIntRaw();
-      Double_t pedestal=hit->GetRawAdcHitNeg().GetPedRaw();
-      ((THcSignalHit*) frNegADCSums->ConstructedAt(nrNegADCHits))->Set(padnum, samplesum);
-      ((THcSignalHit*) frNegADCPeds->ConstructedAt(nrNegADCHits++))->Set(padnum, pedestal);
-    }
     //
     if((btdcraw_pos && badcraw_pos) || (btdcraw_neg && badcraw_neg )) {
       if (good_ielem_posadc != -1) {
@@ -1014,7 +912,7 @@ Int_t THcScintillatorPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
 	fGoodPosTdcTimeUnCorr.at(padnum-1) = tdc_pos*fScinTdcToTime;
 	//tw_corr_pos = fHodoPos_c1[padnum-1]/pow(adcamp_pos/fTdc_Thrs,fHodoPos_c2[padnum-1]) -  fHodoPos_c1[padnum-1]/pow(200./fTdc_Thrs, fHodoPos_c2[padnum-1]);
 	
-	tw_corr_pos =  1./pow(adcamp_pos/fTdc_Thrs,fHodoPos_c2[padnum-1]) -  1./pow(200./fTdc_Thrs, fHodoPos_c2[padnum-1]);
+	tw_corr_pos =  THcHodoscope::TimeWalkPower(adcamp_pos/fTdc_Thrs,fHodoPos_c2[padnum-1]) - fHodoPosTwRef[padnum-1];
 
 	fGoodPosTdcTimeWalkCorr.at(padnum-1) = tdc_pos*fScinTdcToTime -tw_corr_pos;
       }
@@ -1023,7 +921,7 @@ Int_t THcScintillatorPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
 	
 	//tw_corr_neg = fHodoNeg_c1[padnum-1]/pow(adcamp_neg/fTdc_Thrs,fHodoNeg_c2[padnum-1]) -  fHodoNeg_c1[padnum-1]/pow(200./fTdc_Thrs, fHodoNeg_c2[padnum-1]);
 		
-	tw_corr_neg =  1./pow(adcamp_neg/fTdc_Thrs,fHodoNeg_c2[padnum-1]) - 1./pow(200./fTdc_Thrs, fHodoNeg_c2[padnum-1]);
+	tw_corr_neg =  THcHodoscope::TimeWalkPower(adcamp_neg/fTdc_Thrs,fHodoNeg_c2[padnum-1]) - fHodoNegTwRef[padnum-1];
 
 	fGoodNegTdcTimeWalkCorr.at(padnum-1) = tdc_neg*fScinTdcToTime -tw_corr_neg;
 
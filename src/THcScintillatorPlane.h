@@ -44,6 +44,7 @@ class THcScintillatorPlane : public THaSubDetector {
   Int_t GetNelem() {return fNelem;}; // return number of paddles in this plane
   Int_t GetNScinHits() {return fNScinHits;}; // Get # hits in plane (that pass min/max TDC cuts)
   Int_t GetNGoodHits() {return fNGoodHits;}; // Get # hits in plane (used in determining focal plane time)
+  Bool_t UsesADCSamples() {return (fADCMode == kADCSampleIntegral || fADCMode == kADCSampIntDynPed);}; // ADC mode integrates FADC samples
   Double_t GetHitDistance() {return fHitDistance;}; // Distance between track and hit paddle
   Double_t GetTrackXPosition() {return fTrackXPosition;}; // Distance track X position at plane
   Double_t GetTrackYPosition() {return fTrackYPosition;}; // Distance track Y position at plane
@@ -56,6 +57,9 @@ class THcScintillatorPlane : public THaSubDetector {
   Double_t GetPosRight() {return fPosRight;};
   Double_t GetPosOffset() {return fPosOffset;};
   Double_t GetPosCenter(Int_t PaddleNo) {return fPosCenter[PaddleNo];}; // counting from zero!
+  void FindPaddleRange(Double_t pos, Double_t halfwidth, Int_t& first, Int_t& last) const;
+  Bool_t IsPaddleInRange(Int_t PaddleNo, Int_t first, Int_t last) const
+  { return fPaddleRank[PaddleNo] >= first && fPaddleRank[PaddleNo] < last; } // counting from zero!
   Double_t GetFpTime() {return fFptime;};
 
   void SetFpTime(Double_t f) {fFptime=f;};
@@ -70,42 +74,39 @@ class THcScintillatorPlane : public THaSubDetector {
 
  protected:
 
-  TClonesArray* frPosAdcErrorFlag;
-  TClonesArray* frNegAdcErrorFlag;
-
-  TClonesArray* frPosTDCHits;
-  TClonesArray* frNegTDCHits;
-  TClonesArray* frPosADCHits;
-  TClonesArray* frNegADCHits;
-  TClonesArray* frPosADCSums;
-  TClonesArray* frNegADCSums;
-  TClonesArray* frPosADCPeds;
-  TClonesArray* frNegADCPeds;
   TClonesArray* fHodoHits;
 
-  TClonesArray* frPosTdcTimeRaw;
-  TClonesArray* frPosAdcPedRaw;
-  TClonesArray* frPosAdcPulseIntRaw;
-  TClonesArray* frPosAdcPulseAmpRaw;
-  TClonesArray* frPosAdcPulseTimeRaw;
-
-  TClonesArray* frPosTdcTime;
-  TClonesArray* frPosAdcPed;
-  TClonesArray* frPosAdcPulseInt;
-  TClonesArray* frPosAdcPulseAmp;
-  TClonesArray* frPosAdcPulseTime;
-
-  TClonesArray* frNegTdcTimeRaw;
-  TClonesArray* frNegAdcPedRaw;
-  TClonesArray* frNegAdcPulseIntRaw;
-  TClonesArray* frNegAdcPulseAmpRaw;
-  TClonesArray* frNegAdcPulseTimeRaw;
-
-  TClonesArray* frNegTdcTime;
-  TClonesArray* frNegAdcPed;
-  TClonesArray* frNegAdcPulseInt;
-  TClonesArray* frNegAdcPulseAmp;
-  TClonesArray* frNegAdcPulseTime;
+  // Raw TDC hits and ADC pulses, one entry per TDC hit or ADC pulse.
+  // The Counter list has the paddle number of each entry.
+  vector<Int_t>    fPosTdcCounter;
+  vector<Double_t> fPosTdcTimeRaw;
+  vector<Double_t> fPosTdcTime;
+
+  vector<Int_t>    fPosAdcCounter;
+  vector<Double_t> fPosAdcPedRaw;
+  vector<Double_t> fPosAdcPed;
+  vector<Double_t> fPosAdcPulseIntRaw;
+  vector<Double_t> fPosAdcPulseInt;
+  vector<Double_t> fPosAdcPulseAmpRaw;
+  vector<Double_t> fPosAdcPulseAmp;
+  vector<Double_t> fPosAdcPulseTimeRaw;
+  vector<Double_t> fPosAdcPulseTime;
+  vector<Double_t> fPosAdcErrorFlag;	// 1 if the raw pulse amplitude is <= 0
+
+  vector<Int_t>    fNegTdcCounter;
+  vector<Double_t> fNegTdcTimeRaw;
+  vector<Double_t> fNegTdcTime;
+
+  vector<Int_t>    fNegAdcCounter;
+  vector<Double_t> fNegAdcPedRaw;
+  vector<Double_t> fNegAdcPed;
+  vector<Double_t> fNegAdcPulseIntRaw;
+  vector<Double_t> fNegAdcPulseInt;
+  vector<Double_t> fNegAdcPulseAmpRaw;
+  vector<Double_t> fNegAdcPulseAmp;
+  vector<Double_t> fNegAdcPulseTimeRaw;
+  vector<Double_t> fNegAdcPulseTime;
+  vector<Double_t> fNegAdcErrorFlag;
 
   //Hodoscopes Multiplicities
   Int_t fTotNumPosAdcHits;
@@ -187,7 +188,6 @@ class THcScintillatorPlane : public THaSubDetector {
   static const Int_t kADCSampleIntegral=2;
   static const Int_t kADCSampIntDynPed=3;
   Double_t fADCPedScaleFactor;	// Multiply dynamic pedestal by this before subtracting
-  Int_t fADCDiagCut;		// Cut for ADC in hit maps.  Defaults to 50
   Int_t fTdcOffset;		/* Overall offset to raw tdc */
   Double_t fAdcTdcOffset;	/* Overall offset to raw adc times */
   Int_t fMaxHits;               /* maximum number of hits to be considered - useful for dimensioning arrays */
@@ -200,6 +200,8 @@ class THcScintillatorPlane : public THaSubDetector {
   Double_t fPosRight;           /* NOTE: "right" = "top" for a Y scintillator */
   Double_t fPosOffset;
   Double_t *fPosCenter;         /* array with centers for all scintillators in the plane */
+  vector<Double_t> fSortedPos;  /* centers plus offset in increasing order */
+  vector<Int_t> fPaddleRank;    /* position of each paddle in fSortedPos */
   Double_t fScinTdcMin;
   Double_t fScinTdcMax;
   Double_t fStartTimeCenter;
@@ -233,6 +235,8 @@ class THcScintillatorPlane : public THaSubDetector {
   Double_t* fHodoNeg_c1;
   Double_t* fHodoPos_c2;
   Double_t* fHodoNeg_c2;
+  Double_t* fHodoPosTwRef;	// Time walk term at the reference amplitude
+  Double_t* fHodoNegTwRef;
   Double_t  fTdc_Thrs;  
 
   Double_t tw_corr_pos;
@@ -267,6 +271,7 @@ class THcScintillatorPlane : public THaSubDetector {
   virtual Int_t  ReadDatabase( const TDatime& date );
   virtual Int_t  DefineVariables( EMode mode = kDefine );
   virtual void  InitializePedestals( );
+  void          ClearRawHitLists();
 
   ClassDef(THcScintillatorPlane,0); // Scintillator bars in a plane
 };
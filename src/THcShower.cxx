@@ -173,6 +173,13 @@ THaAnalysisObject::EStatus THcShower::Init( const TDatime& date )
     }
   }
 
+  // Only the sample integral modes read every FADC sample.  The fly's
+  // eye array has its own ADC mode.
+  if(fADCMode == kADCSampleIntegral || fADCMode == kADCSampIntDynPed
+     || (fHasArray && fArray->UsesADCSamples())) {
+    SetWantSamples();
+  }
+
   if(fHasArray) {
     // cout << "THcShower::Init: adjustment of fiducial volume limits to the fly's eye part." << endl;
     // cout << "  Old limits:" << endl;
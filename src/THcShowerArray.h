@@ -44,6 +44,10 @@ public:
   virtual Int_t FineProcess( TClonesArray& tracks );
   Bool_t   IsTracking() { return kFALSE; }
   virtual Bool_t   IsPid()      { return kFALSE; }
+  // ADC mode integrates FADC samples, or pedestals come from samples
+  Bool_t UsesADCSamples() const {
+    return (fUsingFADC || fADCMode == kADCSampleIntegral || fADCMode == kADCSampIntDynPed);
+  };
 
   virtual Int_t ProcessHits(TClonesArray* rawhits, Int_t nexthit);
   virtual Int_t CoarseProcessHits();
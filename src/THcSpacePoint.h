@@ -15,7 +15,8 @@ class THcSpacePoint : public TObject {
 public:
 
   THcSpacePoint(Int_t nhits=0, Int_t ncombos=0) :
-  fNHits(nhits), fNCombos(ncombos),fSetStubFlag(kFALSE) {
+  fTrackMask(0), fNHits(nhits), fNCombos(ncombos),fSetStubFlag(kFALSE),
+  fTruncated(kFALSE) {
     fHits.clear();
   }
   virtual ~THcSpacePoint() {}
@@ -29,7 +30,12 @@ public:
   };
 
   void SetXY(Double_t x, Double_t y) {fX = x; fY = y;};
-  void Clear(Option_t* opt="") {fNHits=0; fNCombos=0; fHits.clear();};
+  // Space points are reused from event to event, so reset all
+  // per-event data.  fHits keeps its capacity.
+  void Clear(Option_t* opt="") {
+    fNHits=0; fNCombos=0; fHits.clear();
+    fSetStubFlag=kFALSE; fTrackMask=0; fTruncated=kFALSE;
+  };
   void AddHit(THcDCHit* hit) {
     Hit newhit;
     newhit.dchit = hit;
@@ -43,6 +49,8 @@ public:
   Double_t GetX() {return fX;};
   Double_t GetY() {return fY;};
   Bool_t GetSetStubFlag() {return fSetStubFlag;};
+  void SetTruncated() {fTruncated = kTRUE;};
+  Bool_t IsTruncated() {return fTruncated;};
   THcDCHit* GetHit(Int_t ihit) {return fHits[ihit].dchit;};
   //  std::vector<THcDCHit*>* GetHitVectorP() {return &fHits;};
   //std::vector<Hit>* GetHitStuffVectorP() {return &fHits;};
@@ -78,6 +86,7 @@ public:
   // we need figure out how to avoid confusion between number and index.
   Int_t fNChamber;
   Int_t fNChamber_spnum;
+  UInt_t fTrackMask;		// Bit i set if in track i, set in THcDC::LinkStubs
 
 protected:
 
@@ -90,6 +99,7 @@ protected:
   //std::vector<THcDCHit*> fHits;
   Double_t fStub[4];
   Bool_t fSetStubFlag;
+  Bool_t fTruncated;		// Hits were dropped at the hits per point limit
   // Should we also have a pointer back to the chamber object
 
   ClassDef(THcSpacePoint,0);   // Space Point/stub track in a single drift chamber
@@ -0,0 +1,87 @@
+/** \class THcTimePeakFinder
+    \ingroup DetSupport
+
+\brief Histogram peak of a few times per event
+
+Finds the peak of the paddle times in THcHodoscope.  It gives the same
+results as filling a TH1F with the same binning and calling
+GetMaximumBin, GetRMS and Integral:
+
+- Entries outside [xmin,xmax) are ignored, including for the RMS.
+- GetMaximumBin returns the lowest bin number (1 to nbins) with the
+  largest count, and 1 if there are no entries.
+- GetRMS is computed from the entries, not from the bin centers.
+
+Only a few dozen times are filled per event, so the bins are plain
+integer counts and Reset only clears the bins that were filled.  No
+memory is allocated after the first events.
+
+*/
+#include "THcTimePeakFinder.h"
+#include "TMath.h"
+
+using namespace std;
+
+THcTimePeakFinder::THcTimePeakFinder(Int_t nbins, Double_t xmin,
+				     Double_t xmax) :
+  fNBins(nbins), fXmin(xmin), fXmax(xmax), fNIn(0), fSumX(0.0), fSumX2(0.0)
+{
+  /// Normal constructor.  Same binning arguments as TH1F.
+  fCounts.assign(fNBins, 0);
+  fTouched.reserve(fNBins);
+}
+
+THcTimePeakFinder::~THcTimePeakFinder()
+{
+  /// Destructor
+}
+
+void THcTimePeakFinder::Reset()
+{
+  /// Remove all entries
+  for(UInt_t i=0; i<fTouched.size(); i++) {
+    fCounts[fTouched[i]-1] = 0;
+  }
+  fTouched.clear();
+  fNIn = 0;
+  fSumX = 0.0;
+  fSumX2 = 0.0;
+}
+
+void THcTimePeakFinder::Fill(Double_t x)
+{
+  /// Add one entry.  Bin number as in TAxis::FindBin.
+  if(x < fXmin || !(x < fXmax)) return;
+  Int_t bin = 1 + Int_t(fNBins*(x-fXmin)/(fXmax-fXmin));
+  if(bin > fNBins) return;
+  if(fCounts[bin-1]++ == 0) fTouched.push_back(bin);
+  fNIn++;
+  fSumX += x;
+  fSumX2 += x*x;
+}
+
+Int_t THcTimePeakFinder::GetMaximumBin() const
+{
+  /// Bin number with the most entries, the lowest one if several
+  Int_t maxbin = 1;
+  Int_t maxcount = 0;
+  for(UInt_t i=0; i<fTouched.size(); i++) {
+    Int_t bin = fTouched[i];
+    Int_t count = fCounts[bin-1];
+    if(count > maxcount || (count == maxcount && bin < maxbin)) {
+      maxcount = count;
+      maxbin = bin;
+    }
+  }
+  return maxbin;
+}
+
+Double_t THcTimePeakFinder::GetRMS() const
+{
+  /// Standard deviation of the entries
+  if(fNIn == 0) return 0.0;
+  Double_t mean = fSumX/fNIn;
+  return TMath::Sqrt(TMath::Abs(fSumX2/fNIn - mean*mean));
+}
+
+ClassImp(THcTimePeakFinder)
@@ -0,0 +1,42 @@
+#ifndef ROOT_THcTimePeakFinder
+#define ROOT_THcTimePeakFinder
+
+//////////////////////////////////////////////////////////////////////////
+//
+// THcTimePeakFinder
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "TObject.h"
+
+#include <vector>
+
+class THcTimePeakFinder : public TObject {
+
+public:
+
+  THcTimePeakFinder(Int_t nbins=400, Double_t xmin=0.0, Double_t xmax=200.0);
+  virtual ~THcTimePeakFinder();
+
+  void     Reset();
+  void     Fill(Double_t x);
+
+  Int_t    GetMaximumBin() const;
+  Double_t GetRMS() const;
+  Double_t Integral() const { return fNIn; }
+
+protected:
+
+  Int_t fNBins;
+  Double_t fXmin;
+  Double_t fXmax;
+
+  std::vector<Int_t> fCounts;	// Count of bin i+1
+  std::vector<Int_t> fTouched;	// Bins with counts, to reset and search
+  Int_t fNIn;			// Entries inside the range
+  Double_t fSumX;		// Sum and sum of squares of those entries
+  Double_t fSumX2;
+
+  ClassDef(THcTimePeakFinder,0);  // Histogram peak of a few times per event
+};
+#endif
@@ -41,6 +41,7 @@ the next event comes.
 #include "THaEvData.h"
 #include "THaGlobals.h"
 #include "THcGlobals.h"
+#include "THcDiagnostics.h"
 #include "THcParmList.h"
 #include "THaCodaFile.h"
 #include "THaRunBase.h"
@@ -63,6 +64,10 @@ THcTimeSyncEvtHandler::THcTimeSyncEvtHandler(const char *name, const char* descr
   fBadSyncSizeTrigger = 450;
   fCodaOut = 0;
   fLastEventWasSync = kFALSE;
+  fDiagSlippage = -1;
+  fDiagSyncEvent = -1;
+  fDiagSkippedEvent = -1;
+  fDiagCountDiff = -1;
 }
 
 THcTimeSyncEvtHandler::~THcTimeSyncEvtHandler()
@@ -177,11 +182,19 @@ Int_t THcTimeSyncEvtHandler::Analyze(THaEvData *evdata)
 	    pslippedbank = p-2;
 	    //	    cout << banklen << " " << pslippedbank[0] << endl;
 	    if(AllTdcsPresent(pslippedbank) && (banklen > fBadSyncSizeTrigger)) {
-	      cout << "Slippage detected at event " << evdata->GetEvNum() << " with size " << banklen << " but not corrected" << endl;
+	      if(gHcDiagnostics->Count(fDiagSlippage)) {
+		gHcDiagnostics->Keep(fDiagSlippage,
+				     Form("Slippage detected at event %d with size %d but not corrected",
+					  evdata->GetEvNum(), banklen));
+	      }
 	    }
 	  } else {
 	    if(AllTdcsPresent(p-2) && (banklen > fBadSyncSizeTrigger)) {
-	      cout << "Slippage enabled at event " << evdata->GetEvNum() << " with size " << banklen << endl;
+	      if(gHcDiagnostics->Count(fDiagSlippage)) {
+		gHcDiagnostics->Keep(fDiagSlippage,
+				     Form("Slippage enabled at event %d with size %d",
+					  evdata->GetEvNum(), banklen));
+	      }
 	      fSlippage = 1;
 	    }
 	  }
@@ -209,7 +222,9 @@ Int_t THcTimeSyncEvtHandler::Analyze(THaEvData *evdata)
     fFirstTime = kFALSE;
     fDumpNew=2;
   }
-  if(issyncevent) cout << "SYNC event" << endl;
+  if(issyncevent && gHcDiagnostics->Count(fDiagSyncEvent)) {
+    gHcDiagnostics->Keep(fDiagSyncEvent, Form("SYNC event %d", evdata->GetEvNum()));
+  }
   AccumulateStats(fLastEventWasSync);
   fLastEventWasSync = issyncevent;
 
@@ -220,7 +235,9 @@ Int_t THcTimeSyncEvtHandler::Analyze(THaEvData *evdata)
       fWriteDelayed=kTRUE;
       //      cout << "Will write corrected event" << endl;
     } else {
-      cout << "Skipping event " << evdata->GetEvNum() << endl;
+      if(gHcDiagnostics->Count(fDiagSkippedEvent)) {
+	gHcDiagnostics->Keep(fDiagSkippedEvent, Form("Skipping event %d", evdata->GetEvNum()));
+      }
     }
   } else {			// Not slipping yet, just copy event
     if(fCodaOut) {
@@ -325,7 +342,10 @@ Int_t THcTimeSyncEvtHandler::Analyze(THaEvData *evdata)
       //      cout << dec << endl;
       fCodaOut->codaWrite(fLastEvent);
       if(issyncevent) {		// If this was a sync event, write it out and stop rewriting
-	cout << "Run back in sync at event " << evdata->GetEvNum() << endl;
+	if(gHcDiagnostics->Count(fDiagSlippage)) {
+	  gHcDiagnostics->Keep(fDiagSlippage,
+			       Form("Run back in sync at event %d", evdata->GetEvNum()));
+	}
 	fCodaOut->codaWrite(evdata->GetRawDataBuffer());
 	fSlippage = 0;
 	fLastEvent[0] = 0;
@@ -438,7 +458,11 @@ void THcTimeSyncEvtHandler::AccumulateStats(Bool_t sync) {
 	  ((CrateTimeMap[roc]->ftdcEvCountMap[slot]+rocstats->ftdcEvCountOffsetMap[slot])&0x3fffff);
 	if(sync) { // Need to do this check on the event after the sync event too
 	  if(cdiff>2) {
-	    cout << "ROC/Slot " << roc << "/" << slot << " count diff correction " << cdiff << endl;
+	    if(gHcDiagnostics->Count(fDiagCountDiff)) {
+	      gHcDiagnostics->Keep(fDiagCountDiff,
+				   Form("ROC/Slot %d/%d count diff correction %d",
+					roc, slot, cdiff));
+	    }
 	    rocstats->ftdcEvCountOffsetMap[slot] += cdiff;
 	    cdiff = 0;
 	  }
@@ -502,6 +526,16 @@ THaAnalysisObject::EStatus THcTimeSyncEvtHandler::Init(const TDatime& date)
 
   cout << "Howdy !  We are initializing THcTimeSyncEvtHandler !!   name =   "<<fName<<endl;
 
+  if(!gHcDiagnostics) gHcDiagnostics = new THcDiagnostics;
+  fDiagSlippage = gHcDiagnostics->Register("timesync_slippage",
+					   "Sync slippage changes", 100, 100);
+  fDiagSyncEvent = gHcDiagnostics->Register("timesync_sync_event",
+					    "Sync events");
+  fDiagSkippedEvent = gHcDiagnostics->Register("timesync_skipped_event",
+					       "Events skipped while slipping");
+  fDiagCountDiff = gHcDiagnostics->Register("timesync_count_diff",
+					    "TDC event count corrections");
+
   if(eventtypes.size()==0) {
     eventtypes.push_back(1);  // If no event types specified, 
     eventtypes.push_back(2);  // check timestamp synchronization on these event types
@@ -53,6 +53,10 @@ private:
   Bool_t fLastEventWasSync;	// True when last event was sync event
   Bool_t fFirstTdcCheck;
   UInt_t fTdcMask;		  // Bit Pattern of TDC in ROC being checked
+  Int_t fDiagSlippage;		  // gHcDiagnostics message types
+  Int_t fDiagSyncEvent;
+  Int_t fDiagSkippedEvent;
+  Int_t fDiagCountDiff;
 
   Decoder::THaCodaFile* fCodaOut; // The CODA output file
   Int_t handle;
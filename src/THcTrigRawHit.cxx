@@ -51,6 +51,17 @@ It supports rich data from flash 250 ADC modules.
 \throw std::out_of_range Tried to set wrong signal.
 */
 
+/**
+\fn Bool_t THcTrigRawHit::SetSampleSource(Int_t signal, const THaEvData* evdata, Int_t crate, Int_t slot, Int_t chan)
+\brief Defers reading the waveform samples until they are needed.
+\param[in] signal ADC.
+\param[in] evdata Event data of the current event.
+\param[in] crate,slot,chan Channel holding the samples.
+\throw std::out_of_range Tried to set wrong signal.
+
+See THcRawAdcHit::SetSampleSource.
+*/
+
 /**
 \fn void THcTrigRawHit::SetDataTimePedestalPeak(
   Int_t signal, Int_t data, Int_t time, Int_t pedestal, Int_t peak)
@@ -126,6 +137,11 @@ It supports rich data from flash 250 ADC modules.
 \brief See THcRawAdcHit::SetF250Params.
 */
 
+/**
+\fn void THcTrigRawHit::SetArena(THcRawDataArena* arena)
+\brief See THcRawAdcHit::SetArena and THcRawTdcHit::SetArena.
+*/
+
 // TODO: Check if signal matches plane.
 
 #include "THcTrigRawHit.h"
@@ -202,6 +218,21 @@ void THcTrigRawHit::SetSample(Int_t signal, Int_t data) {
 }
 
 
+Bool_t THcTrigRawHit::SetSampleSource(
+  Int_t signal, const THaEvData* evdata, Int_t crate, Int_t slot, Int_t chan
+) {
+  if (0 <= signal && signal < fNAdcSignals) {
+    fAdcHits[signal].SetSampleSource(evdata, crate, slot, chan);
+    return kTRUE;
+  }
+  else {
+    throw std::out_of_range(
+      "`THcTrigRawHit::SetSampleSource`: only signal `0` available!"
+    );
+  }
+}
+
+
 void THcTrigRawHit::SetDataTimePedestalPeak(
   Int_t signal, Int_t data, Int_t time, Int_t pedestal, Int_t peak
 ) {
@@ -320,4 +351,14 @@ void THcTrigRawHit::SetF250Params(Int_t NSA, Int_t NSB, Int_t NPED) {
 }
 
 
+void THcTrigRawHit::SetArena(THcRawDataArena* arena) {
+  for (Int_t iAdcSig=0; iAdcSig<fNAdcSignals; ++iAdcSig) {
+    fAdcHits[iAdcSig].SetArena(arena);
+  }
+  for (Int_t iTdcSig=0; iTdcSig<fNTdcSignals; ++iTdcSig) {
+    fTdcHits[iTdcSig].SetArena(arena);
+  }
+}
+
+
 ClassImp(THcTrigRawHit)
@@ -8,6 +8,8 @@
 
 
 class THcTrigRawHit : public THcRawHit {
+  friend struct THcRawHitParts<THcTrigRawHit>;
+
   public:
     THcTrigRawHit(Int_t plane=0, Int_t counter=0);
     THcTrigRawHit& operator=(const THcTrigRawHit& right);
@@ -17,6 +19,9 @@ class THcTrigRawHit : public THcRawHit {
 
     void SetData(Int_t signal, Int_t data);
     void SetSample(Int_t signal, Int_t data);
+    virtual Bool_t SetSampleSource(
+      Int_t signal, const THaEvData* evdata, Int_t crate, Int_t slot, Int_t chan
+    );
     void SetDataTimePedestalPeak(
       Int_t signal, Int_t data, Int_t time, Int_t pedestal, Int_t peak
     );
@@ -34,6 +39,7 @@ class THcTrigRawHit : public THcRawHit {
     THcRawTdcHit& GetRawTdcHit();
 
     void SetF250Params(Int_t NSA, Int_t NSB, Int_t NPED);
+    virtual void SetArena(THcRawDataArena* arena);
 
   protected:
     static const Int_t fNAdcSignals = 1;
@@ -46,5 +52,21 @@ class THcTrigRawHit : public THcRawHit {
     ClassDef(THcTrigRawHit, 0);
 };
 
+template<> struct THcRawHitParts<THcTrigRawHit> {
+  static THcRawAdcHit* Adc(THcTrigRawHit& hit, Int_t signal) {
+    if (0 <= signal && signal < THcTrigRawHit::fNAdcSignals) {
+      return &hit.fAdcHits[signal];
+    }
+    return 0;
+  }
+  static THcRawTdcHit* Tdc(THcTrigRawHit& hit, Int_t signal) {
+    Int_t iTdc = signal - THcTrigRawHit::fNAdcSignals;
+    if (0 <= iTdc && iTdc < THcTrigRawHit::fNTdcSignals) {
+      return &hit.fTdcHits[iTdc];
+    }
+    return 0;
+  }
+};
+
 
 #endif  // ROOT_THcTrigRawHit